@@ -4,333 +4,352 @@
 #include "exceptions.hpp"
 
 #include <cstddef>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
 
-namespace sjtu { 
+namespace sjtu {
 
-template<class T>
+/**
+ * block geometry of a deque.
+ * a block takes about Bytes bytes, rounded down to a power of two elements and never
+ * less than 16 of them. a block is split when it runs full and two neighbouring blocks
+ * are merged once they fit together in MergeNum / MergeDen of a block, the gap between
+ * the two keeps a block from bouncing between split and merge.
+ * up to Pool emptied blocks are kept by each deque for reuse.
+ * Checked iterators remember their deque and its modification count and throw
+ * invalid_iterator when misused, unchecked ones leave that to the caller.
+ */
+template<size_t Bytes = 4096, size_t MergeNum = 1, size_t MergeDen = 2, size_t Pool = 4, bool Checked = true>
+struct deque_policy {
+    static_assert(MergeNum < MergeDen, "a merged block must not be full");
+
+    static const int pool = Pool;
+    static const bool checked = Checked;
+
+    template<class T>
+    static constexpr int capacity() {
+        return floor2(Bytes / sizeof(T) < 16 ? 16 : Bytes / sizeof(T));
+    }
+
+    static constexpr int merge_bound(int cap) {
+        return cap * MergeNum / MergeDen;
+    }
+
+private:
+    static constexpr int floor2(size_t x) {
+        return x < 2 ? 1 : 2 * floor2(x / 2);
+    }
+};
+
+// the modification count of a deque. a checked iterator keeps a copy of it so that
+// using the iterator after the deque has changed is caught, unchecked ones carry nothing.
+template<bool Checked>
+struct deque_stamp {
+    unsigned gen;
+
+    deque_stamp() : gen(0) {}
+
+    void touch() {
+        ++gen;
+    }
+
+    bool same(const deque_stamp &other) const {
+        return gen == other.gen;
+    }
+};
+
+template<>
+struct deque_stamp<false> {
+    void touch() {}
+
+    bool same(const deque_stamp &) const {
+        return true;
+    }
+};
+
+template<class T, class Policy = deque_policy<>>
 class deque {
 private:
 
-    struct node {
-        node *pre, *nxt;
-        T v;
-        node(const node &other) : v(other.v), pre(nullptr), nxt(nullptr) {}
-        explicit node(const T &r) : v(r), pre(nullptr), nxt(nullptr) {}
-    };
+    static const bool checked = Policy::checked;
+    typedef deque_stamp<checked> stamp;
+
+    static const int B = Policy::template capacity<T>();
+    static const int b = Policy::merge_bound(B);
+
+    // moves *src into the raw slot dst and ends the lifetime of *src.
+    static void relocate(T *dst, T *src) {
+        new (dst) T(std::move(*src));
+        src->~T();
+    }
 
-    class list { 
+    // one contiguous slab of B slots used as a ring buffer,
+    // the k-th element lives in slot (h + k) mod B.
+    class block {
     public:
-        node *head, *tail;
-        int size;
-        
-        list() : head(nullptr), tail(nullptr), size(0) {}
-
-        list(const list &other) : size(other.size), head(nullptr), tail(nullptr) {
-            node *t = other.head;
-            while (t != nullptr) {
-                if (tail == nullptr) {
-                    head = tail = new node(t->v);
-                } else {
-                    tail->nxt = new node(t->v);
-                    tail->nxt->pre = tail;
-                    tail = tail->nxt;
-                }
-                t = t->nxt;
-            }
-        }
+        T *a;
+        int h, size;
+        block *nxt;    // the next block in the pool
 
-        ~list() {
-            node *t = head, *t2;
-            while (t != nullptr) {
-                t2 = t;
-                t  = t->nxt;
-                delete t2;
-            }
-        }
+        block() : a(static_cast<T *>(operator new(sizeof(T) * B))), h(0), size(0), nxt(nullptr) {}
 
-        node *push_front(const T &a) {
-            if (head == nullptr) {
-                head = tail = new node(a);
-                size = 1;
-            } else {
+        // the block of a deque which owns no memory, it has no slots.
+        explicit block(std::nullptr_t) : a(nullptr), h(0), size(0), nxt(nullptr) {}
+
+        // the constructor it delegates to has finished, so ~block cleans up if a copy throws.
+        block(const block &other) : block() {
+            for (int i = 0; i < other.size; ++i) {
+                new (a + i) T(other[i]);
                 ++size;
-                head->pre = new node(a);
-                head->pre->nxt = head;
-                head = head->pre;
             }
-            return head;
         }
 
-        node *push_back(const T &a) {
-            if (tail == nullptr) {
-                head = tail = new node(a);
-                size = 1;
-            } else {
-                ++size;
-                tail->nxt = new node(a);
-                tail->nxt->pre = tail;
-                tail = tail->nxt;
-            }
-            return tail;
+        ~block() {
+            for (int i = 0; i < size; ++i) slot(i)->~T();
+            operator delete(a);
         }
 
-        void pop_front() {
-            if (size == 0)
-                throw container_is_empty();
-            --size;
-            if (head->nxt == nullptr) {
-                delete head;
-                head = tail = nullptr;
-            } else {
-                head = head->nxt;
-                delete head->pre;
-                head->pre = nullptr;
-            }
+        // k may run one slot past either end.
+        T *slot(int k) const {
+            k += h;
+            if (k >= B) k -= B;
+            else if (k < 0) k += B;
+            return a + k;
         }
 
-        void pop_back() {
-            if (size == 0)
-                throw container_is_empty();
-            --size;
-            if (tail->pre == nullptr) {
-                delete tail;
-                head = tail = nullptr;
-            } else {
-                tail = tail->pre;
-                delete tail->nxt;
-                tail->nxt = nullptr;
-            }
+        T &operator[](int k) {
+            return *slot(k);
         }
 
-        void add(int k, const T &a) {
-            if (k > size)
-                throw index_out_of_bound();
-            if (k == 0) add_front(a);
-            else {
-                ++size;
-                node *t = head;
-                while (--k) t = t->nxt;
-                node *r = new node(a);
-                r->pre = t;
-                r->nxt = t->nxt;
-                if (r->pre != nullptr) r->pre->nxt = r;
-                if (r->nxt != nullptr) r->nxt->pre = r;
-            }
+        const T &operator[](int k) const {
+            return *slot(k);
         }
 
-        node *add_before(node *t, const T &a) {
-            node *p = t->pre, *q = t;
-            node *r = new node(a);
+        template<class... Args>
+        void push_front(Args&&... args) {
+            new (slot(-1)) T(std::forward<Args>(args)...);
+            h = h ? h - 1 : B - 1;
             ++size;
-            r->pre = p; r->nxt = q;
-            if (p != nullptr) p->nxt = r;
-            if (q != nullptr) q->pre = r;
-            if (head == t) head = r;
-            return r;
         }
 
-        node *del(int k) {
-            if (k < 1 || k > size)
-                throw index_out_of_bound();
+        template<class... Args>
+        void push_back(Args&&... args) {
+            new (slot(size)) T(std::forward<Args>(args)...);
+            ++size;
+        }
+
+        void pop_front() {
             if (size == 0)
                 throw container_is_empty();
+            a[h].~T();
+            h = h + 1 == B ? 0 : h + 1;
             --size;
-            node *t = head;
-            while (--k) t = t->nxt;
-            node *p = t->pre, *q = t->nxt;
-            delete t;
-            if (p != nullptr) p->nxt = q;
-            if (q != nullptr) q->pre = p;
-            return q;
         }
 
-        node *del(node *t) {
+        void pop_back() {
             if (size == 0)
                 throw container_is_empty();
-            node *mark = t->nxt;
-            if (t->pre != nullptr) t->pre->nxt = t->nxt;
-            if (t->nxt != nullptr) t->nxt->pre = t->pre;
+            slot(size - 1)->~T();
             --size;
-            if (head == t) head = t->nxt;
-            if (tail == t) tail = t->pre;
-            delete t;
-            return mark;
         }
 
-        T &operator[](int k) {
-            if (k < 1 || k > size)
-                throw index_out_of_bound();
-            node *t = head;
-            while (--k) t = t->nxt;
-            return t->v;
+        // the block must not be full and args must not refer into it, the shorter side is shifted.
+        template<class... Args>
+        void add(int k, Args&&... args) {
+            if (k < size - k) {
+                for (int i = 0; i < k; ++i)
+                    relocate(slot(i - 1), slot(i));
+                h = h ? h - 1 : B - 1;
+            } else {
+                for (int i = size - 1; i >= k; --i)
+                    relocate(slot(i + 1), slot(i));
+            }
+            new (slot(k)) T(std::forward<Args>(args)...);
+            ++size;
         }
 
-        const T &operator[](int k) const {
-            if (k < 1 || k > size)
+        void del(int k) {
+            if (k < 0 || k >= size)
                 throw index_out_of_bound();
-            node *t = head;
-            while (--k) t = t->nxt;
-            return t->v;
+            del(k, 1);
+        }
+
+        // erases the n elements from k on, the shorter side is shifted.
+        void del(int k, int n) {
+            for (int i = k; i < k + n; ++i)
+                slot(i)->~T();
+            if (k < size - k - n) {
+                for (int i = k - 1; i >= 0; --i)
+                    relocate(slot(i + n), slot(i));
+                h = (h + n) % B;
+            } else {
+                for (int i = k + n; i < size; ++i)
+                    relocate(slot(i - n), slot(i));
+            }
+            size -= n;
+        }
+
+        void clear() {
+            del(0, size);
+            h = 0;
         }
 
         T &front() {
             if (size == 0)
                 throw container_is_empty();
-            return head->v;
+            return a[h];
         }
 
         const T &front() const {
             if (size == 0)
                 throw container_is_empty();
-            return head->v;
+            return a[h];
         }
 
         T &back() {
             if (size == 0)
                 throw container_is_empty();
-            return tail->v;
+            return *slot(size - 1);
         }
 
         const T &back() const {
             if (size == 0)
                 throw container_is_empty();
-            return tail->v;
+            return *slot(size - 1);
         }
 
-        void merge_front(list &other) {
-            size += other.size;
-            if (head == nullptr && tail == nullptr) {
-                head = other.head;
-                tail = other.tail;
-                return;
+        void merge_front(block &other) {
+            for (int i = other.size - 1; i >= 0; --i) {
+                relocate(slot(-1), other.slot(i));
+                h = h ? h - 1 : B - 1;
             }
-            if (other.head == nullptr && other.tail == nullptr) {
-                return;
-            }
-            if (head != nullptr) head->pre = other.tail;
-            if (other.tail != nullptr) other.tail->nxt = head;
-            head = other.head;
+            size += other.size;
+            other.size = other.h = 0;
         }
 
-        void merge_back(list &other) {
+        void merge_back(block &other) {
+            for (int i = 0; i < other.size; ++i)
+                relocate(slot(size + i), other.slot(i));
             size += other.size;
-            if (head == nullptr && tail == nullptr) {
-                head = other.head;
-                tail = other.tail;
-                return;
-            }
-            if (other.head == nullptr && other.tail == nullptr) {
-                return;
+            other.size = other.h = 0;
+        }
+
+        // the end of the contiguous run of elements which p lies in.
+        T *run_end(const T *p) const {
+            if (h + size <= B || p >= a + h) return a + (h + size <= B ? h + size : B);
+            return a + (h + size - B);
+        }
+
+        // calls fn(begin, end) on the one or two contiguous runs holding the elements,
+        // base is a with the constness the caller wants to hand out.
+        template<class P, class Fn>
+        void runs(P base, Fn &fn) const {
+            if (h + size <= B) {
+                if (size) fn(base + h, base + h + size);
+            } else {
+                fn(base + h, base + B);
+                fn(base, base + (h + size - B));
             }
-            if (tail != nullptr) tail->nxt = other.head;
-            if (other.head != nullptr) other.head->pre = tail;
-            tail = other.tail;
-        }
-
-        void split(list &l1, list &l2) {
-            int k = size / 2;
-            node *t = head;
-            while (--k) t = t->nxt;
-            l1.head = head;
-            l2.tail = tail;
-            l1.tail = t;
-            l2.head = t->nxt;
-            t->nxt->pre = nullptr;
-            t->nxt = nullptr;
-            l1.size = size / 2;
-            l2.size = size - l1.size;
+        }
+
+        // moves the elements from k on into the empty block other.
+        void split(block &other, int k) {
+            for (int i = k; i < size; ++i)
+                relocate(other.a + i - k, slot(i));
+            other.h = 0;
+            other.size = size - k;
+            size = k;
         }
     };
 
-    struct list_node;
-    
 public:
 	class const_iterator;
-	class iterator {
+	class iterator : private stamp {
         friend class deque;
+        friend class const_iterator;
+	public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef int difference_type;
+        typedef T *pointer;
+        typedef T &reference;
 	private:
-        list_node *p;
-        node *t;
+        int i, j, k;
+        T *p, *e;
         deque *D;
 
+        // a checked iterator must belong to a deque which has not changed since it was made.
+        void verify() const {
+            if (checked && (D == nullptr || !this->same(D->st)))
+                throw invalid_iterator();
+        }
+
         int get_pos() const {
-            if (t == nullptr && p == nullptr) return D->s + 1;
-            node *it = t;
-            list_node *ip = p;
-            int ret = 0;
-            while (it != nullptr) {
-                it = it->pre;
-                ++ret;
-            }
-            ip = ip->pre;
-            while (ip != nullptr) {
-                ret += ip->l.size;
-                ip = ip->pre;
-            }
-            return ret;
+            return i;
         }
 
-        void move_back(const int &n) {
-            if (n == 0) return;
-            if (t == nullptr || p == nullptr)
-                throw invalid_iterator();
-            int k = n;
-            while (k && t->nxt != nullptr)
-                t = t->nxt, --k;
-            if (k == 0) return;
-            if (p->nxt == nullptr) {
-                if (k == 1)
-                    t = nullptr, p = nullptr;
-                else
-                    throw runtime_error();
+        // p points at the element and e at the end of the contiguous run it lies in,
+        // both are null at end(). ++ and -- inside a run are plain pointer steps.
+        void sync() {
+            block *t = D->mp[j];
+            if (k < t->size) p = t->slot(k), e = t->run_end(p);
+            else p = e = nullptr;
+        }
+
+        // the iterator is the i-th element, found at (block j, offset k). end() is i == s,
+        // one past the last slot of the last block. steps inside the block keep j, a step
+        // over a block border goes to the neighbour and longer ones relocate.
+        // a checked iterator is verified before D->mp is read, a stale j may lie outside it.
+        void move(const int &n) {
+            if (checked) verify();
+            if (n > 0 ? k + n < D->mp[j]->size : k + n >= 0) {
+                i += n, k += n;
+                sync();
                 return;
             }
-            p = p->nxt;
-            while (p->size() < k && p->nxt != nullptr)
-                k -= p->size(), p = p->nxt;
-            if (p->size() >= k) {
-               t = p->l.head;
-               while (--k) t = t->nxt;
-               return;
-            } else {
-                if (k == p->l.size + 1)
-                    t = nullptr, p = nullptr;
-                else
+            if (checked) {
+                if (n > 0 && i == D->s)
+                    throw invalid_iterator();
+                if (i + n < 0 || i + n > D->s)
                     throw runtime_error();
             }
-		}
-        
-        void move_front(const int &n) {
-            if (n == 0) return;
-            int k = n;
-            if (t == nullptr && p == nullptr) {
-                p = D->tail;
-                t = p->l.tail;
-                --k;
-            }
-            while (k && t->pre != nullptr) t = t->pre, --k;
-            if (k == 0) return;
-            if (p->pre == nullptr)
-                throw runtime_error();
-            p = p->pre;
-            while (p->size() < k && p->pre != nullptr)
-                k -= p->size(), p = p->pre;
-            if (p->size() >= k) {
-                t = p->l.tail;
-                while (--k) t = t->pre;
-                return;
-            } else
-                throw runtime_error();
+            i += n;
+            if (n == 1 && j < D->last) ++j, k = 0;
+            else if (n == -1 && j > D->first) --j, k = D->mp[j]->size - 1;
+            else D->locate(i, j, k);
+            sync();
         }
 
+        // the slow paths move a copy, so that the address of a loop iterator
+        // never escapes and the compiler keeps it in registers.
+        void step_forward() {
+            if (e - p > 1) ++p, ++i, ++k;
+            else *this = *this + 1;
+        }
+
+        void step_back() {
+            if (checked) verify();
+            if (p && k > 0 && p != D->mp[j]->a) --p, --i, --k;
+            else *this = *this - 1;
+        }
 		/**
 		 * TODO add data members
 		 *   just add whatever you want.
 		 */
 	public:
-        iterator() : p(nullptr), t(nullptr), D(nullptr) {}
-        iterator(const iterator &other) : p(other.p), t(other.t), D(other.D) {}
-        iterator(node *_t, list_node *_p, deque *_D) : p(_p), t(_t), D(_D) {}
+        iterator() : i(0), j(0), k(0), p(nullptr), e(nullptr), D(nullptr) {}
+        iterator(const iterator &other) : stamp(other), i(other.i), j(other.j), k(other.k), p(other.p), e(other.e), D(other.D) {}
+        iterator &operator=(const iterator &other) = default;
+        iterator(int _i, deque *_D) : stamp(_D->st), i(_i), D(_D) {
+            D->locate(i, j, k);
+            sync();
+        }
+        // the i-th element is already known to be at (block j, offset k).
+        iterator(int _i, int _j, int _k, deque *_D) : stamp(_D->st), i(_i), j(_j), k(_k), D(_D) {
+            sync();
+        }
 		/**
 		 * return a new iterator which pointer n-next elements
 		 *   even if there are not enough elements, the behaviour is **undefined**.
@@ -338,30 +357,26 @@ public:
 		 */
 		iterator operator+(const int &n) const {
             iterator it = (*this);
-            if (n > 0) it.move_back(n);
-            else it.move_front(-n);
+            it.move(n);
             return it;
 		}
 		iterator operator-(const int &n) const {
             iterator it = (*this);
-            if (n > 0) it.move_front(n);
-            else it.move_back(-n);
+            it.move(-n);
             return it;
 		}
 		// return th distance between two iterator,
 		// if these two iterators points to different vectors, throw invaild_iterator.
 		int operator-(const iterator &rhs) const {
-            if (D != rhs.D) throw invalid_iterator();
+            if (checked && D != rhs.D) throw invalid_iterator();
             return get_pos() - rhs.get_pos();
 		}
 		iterator operator+=(const int &n) {
-            if (n > 0) move_back(n);
-            else move_front(-n);
+            move(n);
             return *this;
 		}
 		iterator operator-=(const int &n) {
-            if (n > 0) move_front(n);
-            else move_back(-n);
+            move(-n);
             return *this;
 		}
 		/**
@@ -369,14 +384,14 @@ public:
 		 */
 		iterator operator++(int) {
             iterator a = (*this);
-            move_back(1);
+            step_forward();
             return a;
         }
 		/**
 		 * TODO ++iter
 		 */
 		iterator& operator++() {
-            move_back(1);
+            step_forward();
             return *this;
         }
 		/**
@@ -384,162 +399,143 @@ public:
 		 */
 		iterator operator--(int) {
             iterator a = (*this);
-            move_front(1);
+            step_back();
             return a;
         }
 		/**
 		 * TODO --iter
 		 */
 		iterator& operator--() {
-            move_front(1);
+            step_back();
             return *this;
         }
 		/**
 		 * TODO *it
 		 */
 		T& operator*() const {
-            if (t == nullptr || p == nullptr)
+            if (checked && (p == nullptr || !this->same(D->st)))
                 throw invalid_iterator();
-            return t->v;
+            return *p;
         }
 		/**
 		 * TODO it->field
 		 */
 		T* operator->() const noexcept {
-            if (t == nullptr || p == nullptr) return nullptr;
-            return &t->v;
+            return p;
         }
 		/**
 		 * a operator to check whether two iterators are same (pointing to the same memory).
 		 */
 		bool operator==(const iterator &rhs) const {
-            return p == rhs.p && t == rhs.t && D == rhs.D;
+            return i == rhs.i && D == rhs.D;
         }
 		bool operator==(const const_iterator &rhs) const {
-            return p == rhs.p && t == rhs.t && D == rhs.D;
+            return i == rhs.i && D == rhs.D;
         }
 		/**
 		 * some other operator for iterator.
 		 */
 		bool operator!=(const iterator &rhs) const {
-            return p != rhs.p || t != rhs.t;
+            return i != rhs.i;
         }
 		bool operator!=(const const_iterator &rhs) const {
-            return p != rhs.p || t != rhs.t;
+            return i != rhs.i;
         }
 	};
-	class const_iterator {
+	class const_iterator : private stamp {
 		// it should has similar member method as iterator.
 		//  and it should be able to construct from an iterator.
             friend class deque;
+		public:
+            typedef std::random_access_iterator_tag iterator_category;
+            typedef T value_type;
+            typedef int difference_type;
+            typedef const T *pointer;
+            typedef const T &reference;
 		private:
-            const list_node *p;
-            const node *t;
+            int i, j, k;
+            const T *p, *e;
             const deque *D;
 			// data members.
 
+            void verify() const {
+                if (checked && (D == nullptr || !this->same(D->st)))
+                    throw invalid_iterator();
+            }
+
             int get_pos() const {
-                if (t == nullptr && p == nullptr) return D->s + 1;
-                const node *it = t;
-                const list_node *ip = p;
-                int ret = 0;
-                while (it != nullptr) {
-                    it = it->pre;
-                    ++ret;
-                }
-                ip = ip->pre;
-                while (ip != nullptr) {
-                    ret += ip->l.size;
-                    ip = ip->pre;
-                }
-                return ret;
+                return i;
             }
 
-            void move_back(const int &n) {
-                if (n == 0) return;
-                if (t == nullptr || p == nullptr)
-                    throw invalid_iterator();
-                int k = n;
-                while (k && t->nxt != nullptr)
-                    t = t->nxt, --k;
-                if (k == 0) return;
-                if (p->nxt == nullptr) {
-                    if (k == 1)
-                        t = nullptr, p = nullptr;
-                    else
-                        throw runtime_error();
+            void sync() {
+                const block *t = D->mp[j];
+                if (k < t->size) p = t->slot(k), e = t->run_end(p);
+                else p = e = nullptr;
+            }
+
+            void move(const int &n) {
+                if (checked) verify();
+                if (n > 0 ? k + n < D->mp[j]->size : k + n >= 0) {
+                    i += n, k += n;
+                    sync();
                     return;
                 }
-                p = p->nxt;
-                while (p->size() < k && p->nxt != nullptr)
-                    k -= p->size(), p = p->nxt;
-                if (p->size() >= k) {
-                    t = p->l.head;
-                    while (--k) t = t->nxt;
-                    return;
-                } else {
-                    if (k == p->l.size + 1)
-                        t = nullptr, p = nullptr;
-                    else
+                if (checked) {
+                    if (n > 0 && i == D->s)
+                        throw invalid_iterator();
+                    if (i + n < 0 || i + n > D->s)
                         throw runtime_error();
                 }
+                i += n;
+                if (n == 1 && j < D->last) ++j, k = 0;
+                else if (n == -1 && j > D->first) --j, k = D->mp[j]->size - 1;
+                else D->locate(i, j, k);
+                sync();
             }
 
-            void move_front(const int &n) {
-                if (n == 0) return;
-                int k = n;
-                if (t == nullptr && p == nullptr) {
-                    p = D->tail;
-                    t = p->l.tail;
-                    --k;
-                }
-                while (k && t->pre != nullptr) t = t->pre, --k;
-                if (k == 0) return;
-                if (p->pre == nullptr)
-                    throw runtime_error();
-                p = p->pre;
-                while (p->size() < k && p->pre != nullptr)
-                    k -= p->size(), p = p->pre;
-                if (p->size() >= k) {
-                    t = p->l.tail;
-                    while (--k) t = t->pre;
-                    return;
-                } else
-                    throw runtime_error();
+            void step_forward() {
+                if (e - p > 1) ++p, ++i, ++k;
+                else *this = *this + 1;
+            }
+
+            void step_back() {
+                if (checked) verify();
+                if (p && k > 0 && p != D->mp[j]->a) --p, --i, --k;
+                else *this = *this - 1;
             }
 
 		public:
-			const_iterator() : p(nullptr), t(nullptr), D(nullptr) {}
-			const_iterator(const const_iterator &other) : p(other.p), t(other.t), D(other.D) {}
-			const_iterator(const iterator &other) : p(other.p), t(other.t), D(other.D) {}
-            const_iterator(const node *_t, const list_node *_p, const deque *_D) : p(_p), t(_t), D(_D) {}
-			
+			const_iterator() : i(0), j(0), k(0), p(nullptr), e(nullptr), D(nullptr) {}
+			const_iterator(const const_iterator &other) : stamp(other), i(other.i), j(other.j), k(other.k), p(other.p), e(other.e), D(other.D) {}
+			const_iterator &operator=(const const_iterator &other) = default;
+			const_iterator(const iterator &other) : stamp(other), i(other.i), j(other.j), k(other.k), p(other.p), e(other.e), D(other.D) {}
+            const_iterator(int _i, const deque *_D) : stamp(_D->st), i(_i), D(_D) {
+                D->locate(i, j, k);
+                sync();
+            }
+
 			const_iterator operator+(const int &n) const {
 		        const_iterator it = (*this);
-		        if (n > 0) it.move_back(n);
-		        else it.move_front(-n);
+		        it.move(n);
 		        return it;
 			}
 			const_iterator operator-(const int &n) const {
 		        const_iterator it = (*this);
-		        if (n > 0) it.move_front(n);
-		        else it.move_back(-n);
+		        it.move(-n);
 		        return it;
 			}
 			// return th distance between two iterator,
 			// if these two iterators points to different vectors, throw invaild_iterator.
 			int operator-(const const_iterator &rhs) const {
-		        if (D != rhs.D) throw invalid_iterator();
+		        if (checked && D != rhs.D) throw invalid_iterator();
 		        return get_pos() - rhs.get_pos();
 			}
 			const_iterator operator+=(const int &n) {
-		        if (n > 0) move_back(n);
-		        else move_front(-n);
+		        move(n);
 		        return *this;
 			}
 			const_iterator operator-=(const int &n) {
-		        if (n > 0) move_front(n);
-		        else move_back(-n);
+		        move(-n);
 		        return *this;
 			}
 			/**
@@ -547,14 +543,14 @@ public:
 			 */
 			const_iterator operator++(int) {
 		        const_iterator a = (*this);
-		        move_back(1);
+		        step_forward();
 		        return a;
 		    }
 			/**
 			 * TODO ++iter
 			 */
 			const_iterator& operator++() {
-		        move_back(1);
+		        step_forward();
 		        return *this;
 		    }
 			/**
@@ -562,132 +558,621 @@ public:
 			 */
 			const_iterator operator--(int) {
 		        const_iterator a = (*this);
-		        move_front(1);
+		        step_back();
 		        return a;
 		    }
 			/**
 			 * TODO --iter
 			 */
 			const_iterator& operator--() {
-		        move_front(1);
+		        step_back();
 		        return *this;
 		    }
 			/**
 			 * TODO *it
 			 */
 			const T& operator*() const {
-		        if (t == nullptr || p == nullptr)
+		        if (checked && (p == nullptr || !this->same(D->st)))
 		            throw invalid_iterator();
-		        return t->v;
+		        return *p;
 		    }
 			/**
 			 * TODO it->field
 			 */
 			const T* operator->() const noexcept {
-		        if (t == nullptr || p == nullptr) return nullptr;
-		        return &t->v;
+		        return p;
 		    }
 			/**
 			 * a operator to check whether two iterators are same (pointing to the same memory).
 			 */
 			bool operator==(const iterator &rhs) const {
-		        return p == rhs.p && t == rhs.t && D == rhs.D;
+		        return i == rhs.i && D == rhs.D;
 		    }
 			bool operator==(const const_iterator &rhs) const {
-		        return p == rhs.p && t == rhs.t && D == rhs.D;
+		        return i == rhs.i && D == rhs.D;
 		    }
 			/**
 			 * some other operator for iterator.
 			 */
 			bool operator!=(const iterator &rhs) const {
-		        return p != rhs.p || t != rhs.t;
+		        return i != rhs.i;
 		    }
 			bool operator!=(const const_iterator &rhs) const {
-		        return p != rhs.p || t != rhs.t;
+		        return i != rhs.i;
 		    }
 	};
 
 private:
 
-    static const int B = 400;
-    static const int b = 200;
-
-    struct list_node {
-        list_node *pre, *nxt;
-        list l;
-        list_node() : l(), pre(nullptr), nxt(nullptr) {}
-        list_node(const list_node &other) : l(other.l), pre(nullptr), nxt(nullptr) {}
-        ~list_node() {}
-        int size() const {
-            return l.size;
-        }
-        bool have(node *t) {
-            node *tmp = l.head;
-            while (tmp != nullptr) {
-                if (t == tmp) return true;
-                tmp = tmp->nxt;
+    // the blocks live in mp[first..last] with free slots on both sides for growth.
+    // a block holds 1..B elements, only a sole block may be empty. fw is a fenwick
+    // tree over the map slots holding the sizes of the interior blocks (the ones
+    // strictly between first and last), the end blocks count as 0 there so that
+    // push and pop never have to touch it. holes counts the interior blocks which
+    // are not full, while it is 0 positions are found with plain arithmetic.
+    // pool is a list of pn emptied blocks (at most Policy::pool of them) which are
+    // reused by the next split or new end block, so that queue-like traffic and
+    // split/merge churn do not go through the allocator.
+    // an empty deque may own no memory at all: then mcap is 0 and mp is a map of one
+    // empty block shared by all such deques, so reading it needs no special case.
+    // prepare() gives it a map of its own before anything is added.
+    block **mp, *pool;
+    int *fw;
+    int mcap, top, first, last, holes, pn;
+    int s;
+    stamp st;    // touched by every change which moves elements or blocks
+
+    static block **nil_map() {
+        static block nil(nullptr);
+        static block *m[1] = {&nil};
+        return m;
+    }
+
+    void make_nil() {
+        mp = nil_map();
+        fw = nullptr;
+        pool = nullptr;
+        mcap = top = first = last = holes = pn = s = 0;
+    }
+
+    // the deque owns no memory yet, the state is only changed once everything is allocated.
+    void init() {
+        block **nmp = new block *[8];
+        int *nfw = nullptr;
+        try {
+            nfw = new int[9]();
+            nmp[4] = new block();
+        } catch (...) {
+            delete [] nfw;
+            delete [] nmp;
+            throw;
+        }
+        mp = nmp;
+        fw = nfw;
+        mcap = top = 8;
+        first = last = 4;
+    }
+
+    void prepare() {
+        if (mcap == 0) init();
+    }
+
+    void fw_add(int j, int d) {
+        for (++j; j <= mcap; j += j & -j) fw[j] += d;
+    }
+
+    // the interior block holding the i-th element of the interior ones, i becomes the offset in it.
+    int fw_find(int &i) const {
+        int j = 0;
+        for (int t = top; t; t >>= 1)
+            if (j + t <= mcap && fw[j + t] <= i) j += t, i -= fw[j];
+        return j;
+    }
+
+    // puts block j into (d = 1) or takes it out of (d = -1) the summary.
+    void track(int j, int d) {
+        fw_add(j, d * mp[j]->size);
+        if (mp[j]->size < B) holes += d;
+    }
+
+    // block j has just changed its size by d.
+    void resized(int j, int d) {
+        if (j == first || j == last) return;
+        fw_add(j, d);
+        if ((mp[j]->size < B) != (mp[j]->size - d < B))
+            holes += mp[j]->size < B ? 1 : -1;
+    }
+
+    // rebuilds the summary in O(mcap) after the blocks have been moved around in the map.
+    void rebuild() {
+        for (int i = 1; i <= mcap; ++i) fw[i] = 0;
+        holes = 0;
+        for (int i = first + 1; i < last; ++i) {
+            fw[i + 1] = mp[i]->size;
+            if (mp[i]->size < B) ++holes;
+        }
+        for (int i = 1; i <= mcap; ++i)
+            if (i + (i & -i) <= mcap) fw[i + (i & -i)] += fw[i];
+        for (top = 1; top * 2 <= mcap; top *= 2);
+    }
+
+    // the block and the offset of the i-th element, i == s gives end().
+    void locate(int i, int &j, int &k) const {
+        int f = mp[first]->size, l = s - mp[last]->size;
+        if (i < f) {
+            j = first, k = i;
+        } else if (i >= l) {
+            j = last, k = i - l;
+        } else if (holes == 0) {
+            i -= f;
+            j = first + 1 + i / B;
+            k = i % B;
+        } else {
+            k = i - f;
+            j = fw_find(k);
+        }
+    }
+
+    // checked iterators passed in must be current ones of this deque.
+    void own(const iterator &pos) const {
+        if (checked && (pos.D != this || !pos.same(st)))
+            throw invalid_iterator();
+    }
+
+    T &get(int i) const {
+        int j, k;
+        locate(i, j, k);
+        return (*mp[j])[k];
+    }
+
+    // makes sure mp has n free slots before first (back == false) or after last (back == true).
+    void make_room(bool back, int n = 1) {
+        if (back ? last + n < mcap : first >= n) return;
+        int nb = last - first + 1;
+        int ncap = (nb + n) * 2 < mcap ? mcap : (nb + n) * 2 + 2;
+        int nfirst = (ncap - nb) / 2;
+        block **nmp = ncap == mcap ? mp : new block *[ncap];
+        int *nfw = fw;
+        if (nmp != mp) {
+            try {
+                nfw = new int[ncap + 1];
+            } catch (...) {
+                delete [] nmp;
+                throw;
+            }
+        }
+        if (nfirst < first)
+            for (int i = 0; i < nb; ++i) nmp[nfirst + i] = mp[first + i];
+        else
+            for (int i = nb - 1; i >= 0; --i) nmp[nfirst + i] = mp[first + i];
+        if (nmp != mp) {
+            delete [] mp;
+            delete [] fw;
+        }
+        fw = nfw;
+        mp = nmp;
+        mcap = ncap;
+        last += nfirst - first;
+        first = nfirst;
+        rebuild();
+    }
+
+    block *new_block() {
+        block *t = pool;
+        if (t == nullptr) return new block();
+        pool = t->nxt;
+        --pn;
+        return t;
+    }
+
+    // t must be empty.
+    void free_block(block *t) {
+        if (pn == Policy::pool) {
+            delete t;
+            return;
+        }
+        t->nxt = pool;
+        pool = t;
+        ++pn;
+    }
+
+    void release_pool() {
+        while (pool != nullptr) {
+            block *t = pool;
+            pool = t->nxt;
+            delete t;
+        }
+        pn = 0;
+    }
+
+    void add_front_block() {
+        make_room(false);
+        if (first < last) track(first, 1);
+        mp[--first] = new_block();
+    }
+
+    void add_back_block() {
+        make_room(true);
+        if (first < last) track(last, 1);
+        mp[++last] = new_block();
+    }
+
+    // drops the first or the last block once it runs empty.
+    void drop_front_block() {
+        if (first < last && mp[first]->size == 0) {
+            free_block(mp[first++]);
+            if (first < last) track(first, -1);
+        }
+    }
+
+    void drop_back_block() {
+        if (first < last && mp[last]->size == 0) {
+            free_block(mp[last--]);
+            if (first < last) track(last, -1);
+        }
+    }
+
+    // moves the back half of the full block j into a new block right after it.
+    // returns the slot of block j, which moves if the map had to be rearranged.
+    int split_block(int j) {
+        j -= first;
+        make_room(true);
+        j += first;
+        for (int i = last; i > j; --i) mp[i + 1] = mp[i];
+        ++last;
+        mp[j + 1] = new_block();
+        mp[j]->split(*mp[j + 1], mp[j]->size / 2);
+        rebuild();
+        return j;
+    }
+
+    // moves block j + 1 into block j and removes it from the map, the summary is left to the caller.
+    void merge_blocks(int j) {
+        mp[j]->merge_back(*mp[j + 1]);
+        free_block(mp[j + 1]);
+        for (int i = j + 1; i < last; ++i) mp[i] = mp[i + 1];
+        --last;
+    }
+
+    // merges the blocks j and j + 1 if both exist and they fit in b together.
+    bool try_merge(int j) {
+        if (j >= first && j < last && mp[j]->size + mp[j + 1]->size <= b) {
+            merge_blocks(j);
+            return true;
+        }
+        return false;
+    }
+
+    // (j, k) == (j, size) names the first element of the next block, or end() past the last one.
+    void settle(int &j, int &k) const {
+        if (j > last) j = last, k = mp[last]->size;
+        else if (k == mp[j]->size && j < last) ++j, k = 0;
+    }
+
+    // makes this a copy of other. the new map and blocks are built on the side and freed
+    // again if an element fails to copy, the old contents are only released after that.
+    void copy_from(const deque &other) {
+        if (other.mcap == 0) {
+            clear2();
+            return;
+        }
+        int n = other.last - other.first + 1, c = 0;
+        block **nmp = new block *[other.mcap], **src = other.mp + other.first;
+        int *nfw = nullptr;
+        try {
+            nfw = new int[other.mcap + 1];
+            for (; c < n; ++c) nmp[other.first + c] = new block(*src[c]);
+        } catch (...) {
+            for (int i = 0; i < c; ++i) delete nmp[other.first + i];
+            delete [] nfw;
+            delete [] nmp;
+            throw;
+        }
+        clear2();
+        mp = nmp;
+        fw = nfw;
+        mcap = other.mcap;
+        first = other.first;
+        last = other.last;
+        s = other.s;
+        rebuild();
+    }
+
+    template<class InputIt>
+    static int distance(InputIt b, InputIt e) {
+        int k = 0;
+        for (; b != e; ++b) ++k;
+        return k;
+    }
+
+    // a forward range is counted first so that the map is grown only once.
+    template<class ForwardIt>
+    void append_range(ForwardIt b, ForwardIt e, std::forward_iterator_tag) {
+        append_range(b, e, distance(b, e));
+    }
+
+    // a single-pass range can only be read once, the map grows as the blocks fill up.
+    template<class InputIt>
+    void append_range(InputIt b, InputIt e, std::input_iterator_tag) {
+        append_range(b, e, 0);
+    }
+
+    // appends [b, e), reading it once. room for k elements is made up front, each block is
+    // filled in one go and the size summary is rebuilt once at the end.
+    // if an element fails to copy the ones appended so far are removed again.
+    template<class InputIt>
+    void append_range(InputIt b, InputIt e, int k) {
+        st.touch();
+        if (!(b != e)) return;
+        prepare();
+        int room = B - mp[last]->size, s0 = s;
+        try {
+            if (k > room) make_room(true, (k - room + B - 1) / B);
+            for (; b != e; ++b) {
+                if (mp[last]->size == B) {
+                    make_room(true);
+                    mp[++last] = new_block();
+                }
+                mp[last]->push_back(*b);
+                ++s;
+            }
+        } catch (...) {
+            if (s0 == 0) {
+                clear2();
+                throw;
             }
-            return false;
+            if (mp[last]->size == 0) free_block(mp[last--]);
+            rebuild();
+            int j, kk;
+            if (s > s0) erase_range(s0, s, j, kk);
+            throw;
+        }
+        rebuild();
+    }
+
+    // appends the n blocks src[0..n) holding cnt elements to the map, the seam is merged if it got small.
+    void attach_back(block **src, int n, int cnt) {
+        st.touch();
+        if (n == 0) return;
+        prepare();
+        make_room(true, n);
+        if (s == 0) free_block(mp[last--]);
+        for (int i = 0; i < n; ++i) mp[++last] = src[i];
+        s += cnt;
+        try_merge(last - n);
+        rebuild();
+    }
+
+    void take(deque &other) {
+        mp = other.mp;
+        pool = other.pool;
+        pn = other.pn;
+        fw = other.fw;
+        mcap = other.mcap;
+        top = other.top;
+        first = other.first;
+        last = other.last;
+        holes = other.holes;
+        s = other.s;
+        other.make_nil();
+        other.st.touch();
+    }
+
+    // inserts before the i-th element (0 < i < s). a full block first hands one element
+    // to a neighbour with room, and only splits in halves when both neighbours are full.
+    // (j, k) is left at the new element. it is built before anything moves because
+    // args may refer to an element of this deque.
+    template<class... Args>
+    void insert_middle(int i, int &j, int &k, Args&&... args) {
+        T tmp(std::forward<Args>(args)...);
+        st.touch();
+        locate(i, j, k);
+        if (k == 0) --j, k = mp[j]->size;
+        if (mp[j]->size == B) {
+            if (k < B && j < last && mp[j + 1]->size < B) {
+                mp[j + 1]->push_front(std::move(mp[j]->back()));
+                mp[j]->pop_back();
+                resized(j + 1, 1);
+                resized(j, -1);
+            } else if (j > first && mp[j - 1]->size < B) {
+                mp[j - 1]->push_back(std::move(mp[j]->front()));
+                mp[j]->pop_front();
+                resized(j - 1, 1);
+                resized(j, -1);
+                --k;
+            } else {
+                j = split_block(j);
+                if (k > mp[j]->size) k -= mp[j]->size, ++j;
+            }
+        }
+        mp[j]->add(k, std::move(tmp));
+        resized(j, 1);
+    }
+
+    // removes the i-th element. an interior block which runs empty, or gets small enough to
+    // share half a block with a neighbour, is merged into it.
+    // (j, k) is left at the element which followed it.
+    void erase_at(int i, int &j, int &k) {
+        st.touch();
+        locate(i, j, k);
+        mp[j]->del(k);
+        resized(j, -1);
+        if (j == first) {
+            drop_front_block();
+            if (j < first) j = first, k = 0;
+        } else if (j == last) {
+            drop_back_block();
+        } else if (mp[j]->size < b) {
+            int x = mp[j - 1]->size < mp[j + 1]->size ? j - 1 : j;
+            if (mp[x]->size + mp[x + 1]->size <= b || mp[j]->size == 0) {
+                if (x < j) k += mp[x]->size, j = x;
+                merge_blocks(x);
+                rebuild();
+            }
+        }
+        settle(j, k);
+    }
+
+    // n copies of *v as an input range.
+    struct repeat_iterator {
+        const T *v;
+        int n;
+        const T &operator*() const {
+            return *v;
+        }
+        repeat_iterator &operator++() {
+            --n;
+            return *this;
+        }
+        bool operator!=(const repeat_iterator &rhs) const {
+            return n != rhs.n;
         }
     };
 
-    list_node *balance(list_node *t) {
-        if (t->l.size > B) {
-            list_node *l1 = new list_node(), *l2 = new list_node();
-            t->l.split(l1->l, l2->l);
-            l1->pre = t->pre;
-            l1->nxt = l2;
-            l2->pre = l1;
-            l2->nxt = t->nxt;
-            if (l1->pre != nullptr) l1->pre->nxt = l1;
-            if (l2->nxt != nullptr) l2->nxt->pre = l2;
-            if (head == t) head = l1;
-            if (tail == t) tail = l2;
-            operator delete(t);
-            return l1;
-        } else if (t->l.size < b) {
-           while (t->pre != nullptr && t->pre->size() + t->l.size <= B ) {
-               t->l.merge_front(t->pre->l);
-               if (head == t->pre) head = t;
-               list_node *d = t->pre;
-               t->pre = t->pre->pre;
-               if (t->pre != nullptr) t->pre->nxt = t;
-               operator delete (d);
-           }
-           while (t->nxt != nullptr && t->nxt->size() + t->l.size <= B) {
-               t->l.merge_back(t->nxt->l);
-               if (tail == t->nxt) tail = t;
-               list_node *d = t->nxt;
-               t->nxt = t->nxt->nxt;
-               if (t->nxt != nullptr) t->nxt->pre = t;
-               operator delete (d);
-           }
+    // a forward range is counted first so that its blocks are spliced in at once.
+    template<class ForwardIt>
+    void insert_range(int i, ForwardIt b, ForwardIt e, std::forward_iterator_tag, int &rj, int &rk) {
+        insert_range(i, b, e, distance(b, e), rj, rk);
+    }
+
+    // a single-pass range is appended to the elements before i, the rest are cut off first
+    // and put back after it.
+    template<class InputIt>
+    void insert_range(int i, InputIt b, InputIt e, std::input_iterator_tag, int &rj, int &rk) {
+        deque tail = split_at(i);
+        try {
+            append_range(b, e, 0);
+        } catch (...) {
+            splice_back(std::move(tail));
+            throw;
         }
-        return t;
+        splice_back(std::move(tail));
+        locate(i, rj, rk);
     }
 
-    list_node *head, *tail;
-    int s;
+    // inserts the k elements of [b, e) before the i-th element. the block holding it is cut
+    // there, the new elements fill the rest of its front part and then fresh blocks which
+    // are spliced into the map in one go, the cut-off back part follows them. only the two
+    // seams are merged if they got small, and the summary is rebuilt once.
+    // if an element fails to copy, the fresh blocks left empty are taken out of the map
+    // again and the elements inserted so far are removed, moving an element must not throw.
+    // (rj, rk) is left at the first new element, k must not be 0.
+    template<class InputIt>
+    void insert_range(int i, InputIt b, InputIt e, int k, int &rj, int &rk) {
+        st.touch();
+        if (i == s) {
+            rj = last - first, rk = mp[last]->size;
+            append_range(b, e, k);
+            rj += first;
+            settle(rj, rk);
+            return;
+        }
+        int j, kk;
+        locate(i, j, kk);
+        int room = kk ? B - kk : 0;
+        int nb = k > room ? (k - room + B - 1) / B : 0, cnt = nb + (kk ? 1 : 0);
+        j -= first;
+        make_room(true, cnt);
+        j += first;
+        int at = kk ? j + 1 : j, s0 = s, t = kk ? j : at;
+        for (int u = last; u >= at; --u) mp[u + cnt] = mp[u];
+        for (int u = at; u < at + cnt; ++u) mp[u] = nullptr;
+        last += cnt;
+        try {
+            for (int u = at; u < at + nb; ++u) mp[u] = new_block();
+            if (kk) {
+                mp[at + nb] = new_block();
+                mp[j]->split(*mp[at + nb], kk);
+            }
+            for (; b != e; ++b) {
+                if (mp[t]->size == B) ++t;
+                mp[t]->push_back(*b);
+                ++s;
+            }
+        } catch (...) {
+            int w = at;
+            for (int u = at; u <= last; ++u) {
+                if (u >= at + cnt || (mp[u] != nullptr && mp[u]->size)) mp[w++] = mp[u];
+                else if (mp[u] != nullptr) free_block(mp[u]);
+            }
+            last = w - 1;
+            rebuild();
+            int x, y;
+            if (s > s0) erase_range(i, i + s - s0, x, y);
+            throw;
+        }
+        try_merge(t);
+        rj = kk ? j : at, rk = kk;
+        if (kk == 0 && at > first) {
+            int m = mp[at - 1]->size;
+            if (try_merge(at - 1)) rj = at - 1, rk = m;
+        }
+        rebuild();
+    }
+
+    // removes the elements with index in [x, y). the blocks in between are dropped whole,
+    // the two boundary blocks are trimmed and merged if they got small.
+    // (rj, rk) is left at the element which followed them, x must be less than y.
+    void erase_range(int x, int y, int &rj, int &rk) {
+        st.touch();
+        if (x == 0 && y == s) {
+            clear();
+            rj = first, rk = 0;
+            return;
+        }
+        int j1, k1, j2, k2;
+        locate(x, j1, k1);
+        locate(y, j2, k2);
+        if (j1 == j2) {
+            mp[j1]->del(k1, k2 - k1);
+        } else {
+            mp[j1]->del(k1, mp[j1]->size - k1);
+            mp[j2]->del(0, k2);
+        }
+        int lo = mp[j1]->size ? j1 + 1 : j1, hi = mp[j2]->size ? j2 - 1 : j2;
+        if (lo <= hi) {
+            for (int t = lo; t <= hi; ++t) {
+                mp[t]->clear();
+                free_block(mp[t]);
+            }
+            for (int t = hi + 1; t <= last; ++t) mp[t - (hi - lo + 1)] = mp[t];
+            last -= hi - lo + 1;
+        }
+        s -= y - x;
+        if (lo > j1 && mp[j1]->size > k1) rj = j1, rk = k1;
+        else rj = lo, rk = 0;
+        if (lo > first && lo <= last) {
+            int m = mp[lo - 1]->size;
+            if (try_merge(lo - 1) && rj == lo) rj = lo - 1, rk += m;
+        }
+        settle(rj, rk);
+        rebuild();
+    }
 
 public:
 	/**
 	 * TODO Constructors
 	 */
-	deque() : s(0) {
-        head = tail = new list_node();
-    }
-	deque(const deque &other) : s(other.s), head(nullptr), tail(nullptr) {
-        list_node *t = other.head;
-        while (t != nullptr) {
-            if (head == nullptr) {
-                head = tail = new list_node(*t);
-            } else {
-                tail->nxt = new list_node(*t);
-                tail->nxt->pre = tail;
-                tail = tail->nxt;
-            }
-            t = t->nxt;
-        }
+	deque() {
+        make_nil();
+    }
+	deque(const deque &other) {
+        make_nil();
+        copy_from(other);
+    }
+	/**
+	 * builds the deque from a copy of [b, e), block by block.
+	 */
+	template<class InputIt, class = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+	deque(InputIt b, InputIt e) {
+        make_nil();
+        append_range(b, e, typename std::iterator_traits<InputIt>::iterator_category());
+    }
+	/**
+	 * takes over the blocks of other in O(1), other is left empty and owns no memory.
+	 */
+	deque(deque &&other) noexcept {
+        take(other);
     }
 	/**
 	 * TODO Deconstructor
@@ -700,79 +1185,107 @@ public:
 	 */
 	deque &operator=(const deque &other) {
 	    if (&other == this) return *this;
+        copy_from(other);
+        return *this;
+    }
+
+	deque &operator=(deque &&other) noexcept {
+	    if (&other == this) return *this;
         clear2();
-        s = other.s;
-        list_node *t = other.head;
-        while (t != nullptr) {
-            if (head == nullptr) {
-                head = tail = new list_node(*t);
-            } else {
-                tail->nxt = new list_node(*t);
-                tail->nxt->pre = tail;
-                tail = tail->nxt;
-            }
-            t = t->nxt;
-        }
+        take(other);
         return *this;
+    }
+	/**
+	 * replaces the contents with a copy of [b, e).
+	 * [b, e) must not point into this deque.
+	 */
+	template<class InputIt, class = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+	void assign(InputIt b, InputIt e) {
+        clear();
+        append_range(b, e, typename std::iterator_traits<InputIt>::iterator_category());
+    }
+	/**
+	 * adds a copy of [b, e) to the end, filling whole blocks directly.
+	 * [b, e) must not point into this deque.
+	 */
+	template<class InputIt, class = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+	void append(InputIt b, InputIt e) {
+        append_range(b, e, typename std::iterator_traits<InputIt>::iterator_category());
+    }
+	/**
+	 * adds n copies of value to the end, filling whole blocks directly.
+	 */
+	void append(size_t n, const T &value) {
+        T tmp(value);
+        append_range(repeat_iterator{&tmp, (int)n}, repeat_iterator{&tmp, 0}, (int)n);
+    }
+	/**
+	 * moves all the elements of other to the end, other is left empty.
+	 * the blocks are handed over as they are, only the two blocks at the seam may be merged.
+	 */
+	void splice_back(deque &&other) {
+        if (&other == this || other.s == 0) return;
+        attach_back(other.mp + other.first, other.last - other.first + 1, other.s);
+        other.last = other.first - 1;
+        other.clear();
+    }
+	/**
+	 * splits the deque before the element at pos: the elements from pos on are
+	 * moved into the returned deque, the first pos elements stay here.
+	 * only the block holding pos is cut, the blocks after it are handed over whole.
+	 * throw index_out_of_bound if pos > size().
+	 */
+	deque split_at(const size_t &pos) {
+        if (pos > (size_t)s)
+            throw index_out_of_bound();
+        int p = pos;
+        deque r;
+        if (p == s) return r;
+        st.touch();
+        if (p == 0) {
+            r.splice_back(std::move(*this));
+            return r;
+        }
+        int j, k;
+        locate(p, j, k);
+        // r gets room for all the blocks it takes before block j is cut, so that nothing
+        // can fail once the elements are on their way.
+        r.prepare();
+        r.make_room(true, last - j + 1);
+        if (k) {
+            block *t = new_block();
+            mp[j]->split(*t, k);
+            r.attach_back(&t, 1, t->size);
+            ++j;
+        }
+        r.attach_back(mp + j, last - j + 1, s - p - r.s);
+        last = j - 1;
+        s = p;
+        rebuild();
+        return r;
     }
 	/**
 	 * access specified element with bounds checking
 	 * throw index_out_of_bound if out of bound.
 	 */
 	T & at(const size_t &pos) {
-        if (pos < 0 || pos >= s)
+        if (pos >= s)
             throw index_out_of_bound();
-        list_node *t = head;
-        int k = pos + 1;
-        while (t != nullptr) {
-            if (t->size() >= k) return t->l[k];
-            else {
-                k -= t->size();
-                t = t->nxt;
-            }
-        }
+        return get(pos);
     }
-    
+
 	const T & at(const size_t &pos) const {
-        if (pos < 0 || pos >= s)
+        if (pos >= s)
             throw index_out_of_bound();
-        list_node *t = head;
-        int k = pos + 1;
-        while (t != nullptr) {
-            if (t->size() >= k) return t->l[k];
-            else {
-                k -= t->size();
-                t = t->nxt;
-            }
-        }
+        return get(pos);
     }
 
 	T & operator[](const size_t &pos) {
-        if (pos < 0 || pos >= s)
-            throw index_out_of_bound();
-        list_node *t = head;
-        int k = pos + 1;
-        while (t != nullptr) {
-            if (t->size() >= k) return t->l[k];
-            else {
-                k -= t->size();
-                t = t->nxt;
-            }
-        }
+        return at(pos);
     }
-    
+
 	const T & operator[](const size_t &pos) const {
-        if (pos < 0 || pos >= s)
-            throw index_out_of_bound();
-        list_node *t = head;
-        int k = pos + 1;
-        while (t != nullptr) {
-            if (t->size() >= k) return t->l[k];
-            else {
-                k -= t->size();
-                t = t->nxt;
-            }
-        }
+        return at(pos);
     }
 	/**
 	 * access the first element
@@ -781,7 +1294,7 @@ public:
 	const T & front() const {
         if (s == 0)
             throw container_is_empty();
-        return head->l.front();
+        return mp[first]->front();
     }
 	/**
 	 * access the last element
@@ -790,29 +1303,41 @@ public:
 	const T & back() const {
         if (s == 0)
             throw container_is_empty();
-        return tail->l.back();
+        return mp[last]->back();
     }
 	/**
 	 * returns an iterator to the beginning.
 	 */
 	iterator begin() {
-        if (s == 0) return iterator(nullptr, nullptr, this);
-        else return iterator(head->l.head, head, this);
+        return iterator(0, this);
     }
 	const_iterator cbegin() const {
-        if (s == 0) return const_iterator(nullptr, nullptr, this);
-        else return const_iterator(head->l.head, head, this);
+        return const_iterator(0, this);
     }
 	/**
 	 * returns an iterator to the end.
 	 */
 	iterator end() {
-	    return iterator(nullptr, nullptr, this);
+	    return iterator(s, this);
 	}
 
 	const_iterator cend() const {
-	    return const_iterator(nullptr, nullptr, this);
+	    return const_iterator(s, this);
 	}
+	/**
+	 * calls fn(T *begin, T *end) on the contiguous runs of elements from front to back.
+	 * a block gives one run, or two when its ring buffer wraps around, so a loop over
+	 * [begin, end) runs at array speed. fn must not change the size of the deque.
+	 */
+	template<class Fn>
+	void for_each_segment(Fn fn) {
+        for (int j = first; j <= last; ++j) mp[j]->runs(mp[j]->a, fn);
+    }
+
+	template<class Fn>
+	void for_each_segment(Fn fn) const {
+        for (int j = first; j <= last; ++j) mp[j]->runs(static_cast<const T *>(mp[j]->a), fn);
+    }
 	/**
 	 * checks whether the container is empty.
 	 */
@@ -823,25 +1348,47 @@ public:
 	 * clears the contents
 	 */
     void clear2() {
-        s = 0;
-        list_node *t = head, *t2;
-        while (t != nullptr) {
-            t2 = t;
-            t = t->nxt;
-            delete t2;
+        st.touch();
+        if (mcap) {
+            for (int i = first; i <= last; ++i) delete mp[i];
+            delete [] mp;
+            delete [] fw;
         }
-        head = tail = nullptr;
+        release_pool();
+        make_nil();
     }
 
     void clear() {
-        s = 0;
-        list_node *t = head, *t2;
-        while (t != nullptr) {
-            t2 = t;
-            t = t->nxt;
-            delete t2;
+        clear2();
+    }
+	/**
+	 * gives the pooled blocks back to the allocator and shrinks the block map
+	 * to the blocks in use.
+	 */
+	void shrink_to_fit() {
+        st.touch();
+        release_pool();
+        if (mcap == 0) return;
+        int nb = last - first + 1, ncap = nb + 2 < 8 ? 8 : nb + 2;
+        if (ncap == mcap) return;
+        block **nmp = new block *[ncap];
+        int *nfw;
+        try {
+            nfw = new int[ncap + 1];
+        } catch (...) {
+            delete [] nmp;
+            throw;
         }
-        head = tail = new list_node();
+        int nfirst = (ncap - nb) / 2;
+        for (int i = 0; i < nb; ++i) nmp[nfirst + i] = mp[first + i];
+        delete [] mp;
+        delete [] fw;
+        mp = nmp;
+        fw = nfw;
+        mcap = ncap;
+        last += nfirst - first;
+        first = nfirst;
+        rebuild();
     }
 	/**
 	 * returns the number of elements
@@ -856,17 +1403,56 @@ public:
 	 *     throw if the iterator is invalid or it point to a wrong place.
 	 */
 	iterator insert(iterator pos, const T &value) {
-	    if (pos.D != this)
-	        throw invalid_iterator();
-	    node *t;
-        if (pos.p == nullptr || pos.t == nullptr)
-            t = push_back(value), pos.p = tail, --s;
-        else
-            t = pos.p->l.add_before(pos.t, value);
-        list_node *p = balance(pos.p);
-        if (!p->have(t)) p = p->nxt;
+        return emplace(pos, value);
+    }
+	iterator insert(iterator pos, T &&value) {
+        return emplace(pos, std::move(value));
+    }
+	/**
+	 * constructs an element from args in place before pos.
+	 * returns an iterator pointing to the new element.
+	 */
+	template<class... Args>
+	iterator emplace(iterator pos, Args&&... args) {
+        own(pos);
+        int i = pos.get_pos();
+        if (i == 0) {
+            emplace_front(std::forward<Args>(args)...);
+            return iterator(0, first, 0, this);
+        }
+        if (i == s) {
+            emplace_back(std::forward<Args>(args)...);
+            return iterator(i, last, mp[last]->size - 1, this);
+        }
+        int j, k;
+        insert_middle(i, j, k, std::forward<Args>(args)...);
         ++s;
-        return iterator(t, p, pos.D);
+        return iterator(i, j, k, this);
+    }
+	/**
+	 * inserts a copy of [b, e) before pos.
+	 * returns an iterator pointing to the first inserted value (pos if the range is empty).
+	 * [b, e) must not point into this deque.
+	 */
+	template<class InputIt, class = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+	iterator insert(iterator pos, InputIt b, InputIt e) {
+        own(pos);
+        int i = pos.get_pos(), j, k;
+        if (!(b != e)) return iterator(i, this);
+        insert_range(i, b, e, typename std::iterator_traits<InputIt>::iterator_category(), j, k);
+        return iterator(i, j, k, this);
+    }
+	/**
+	 * inserts n copies of value before pos.
+	 * returns an iterator pointing to the first inserted value (pos if n is 0).
+	 */
+	iterator insert(iterator pos, size_t n, const T &value) {
+        own(pos);
+        int i = pos.get_pos(), j, k;
+        if (n == 0) return iterator(i, this);
+        T tmp(value);
+        insert_range(i, repeat_iterator{&tmp, (int)n}, repeat_iterator{&tmp, 0}, n, j, k);
+        return iterator(i, j, k, this);
     }
 	/**
 	 * removes specified element at pos.
@@ -875,70 +1461,87 @@ public:
 	 * throw if the container is empty, the iterator is invalid or it points to a wrong place.
 	 */
 	iterator erase(iterator pos) {
-        if (pos.D != this)
-            throw invalid_iterator();
-        if (pos.p == nullptr || pos.t == nullptr)
+        own(pos);
+        int i = pos.get_pos();
+        if (i >= s)
             throw invalid_iterator();
-        node *t = pos.p->l.del(pos.t);
+        int j, k;
+        erase_at(i, j, k);
         --s;
-        list_node *p = pos.p;
-        if (t == nullptr) {
-            p = p->nxt;
-            if (p != nullptr) t = p->l.head;
-            else t = nullptr;
-            list_node *mark = balance(pos.p);
-            if (t == nullptr)
-                return iterator(nullptr, nullptr, pos.D);
-            else {
-                if (mark->have(t)) p = mark;
-                return iterator(t, p, pos.D);
-            }
-        }
-
-        list_node *mark = balance(p);
-        return iterator(t, mark, pos.D);
+        return iterator(i, j, k, this);
+    }
+	/**
+	 * removes the elements in [b, e).
+	 * returns an iterator pointing to the element following the removed ones.
+	 */
+	iterator erase(iterator b, iterator e) {
+        own(b);
+        own(e);
+        int x = b.get_pos(), y = e.get_pos();
+        if (x > y || y > s)
+            throw invalid_iterator();
+        if (x == y) return iterator(x, this);
+        int j, k;
+        erase_range(x, y, j, k);
+        return iterator(x, j, k, this);
     }
 	/**
 	 * adds an element to the end
 	 */
-	node *push_back(const T &value) {
-        //static int times = 0;
-        //printf("%d\n",++times);
-        node *t = tail->l.push_back(value);
-        balance(tail);
+	void push_back(const T &value) {
+        emplace_back(value);
+    }
+	void push_back(T &&value) {
+        emplace_back(std::move(value));
+    }
+	template<class... Args>
+	void emplace_back(Args&&... args) {
+        st.touch();
+        prepare();
+        if (mp[last]->size == B) add_back_block();
+        mp[last]->push_back(std::forward<Args>(args)...);
         ++s;
-        return t;
     }
 	/**
 	 * removes the last element
 	 *     throw when the container is empty.
 	 */
 	void pop_back() {
+        st.touch();
         if (s == 0)
             throw container_is_empty();
-        tail->l.pop_back();
-        balance(tail);
+        mp[last]->pop_back();
         --s;
+        drop_back_block();
     }
 	/**
 	 * inserts an element to the beginning.
 	 */
-	node *push_front(const T &value) {
-        node *t = head->l.push_front(value);
-        balance(head);
+	void push_front(const T &value) {
+        emplace_front(value);
+    }
+	void push_front(T &&value) {
+        emplace_front(std::move(value));
+    }
+	template<class... Args>
+	void emplace_front(Args&&... args) {
+        st.touch();
+        prepare();
+        if (mp[first]->size == B) add_front_block();
+        mp[first]->push_front(std::forward<Args>(args)...);
         ++s;
-        return t;
     }
 	/**
 	 * removes the first element.
 	 *     throw when the container is empty.
 	 */
 	void pop_front() {
+        st.touch();
         if (s == 0)
             throw container_is_empty();
-        head->l.pop_front();
-        balance(head);
+        mp[first]->pop_front();
         --s;
+        drop_front_block();
     }
 };
 
@@ -0,0 +1,183 @@
+#include <iostream>
+#include <ctime>
+#include <deque>
+#include <string>
+#include <random>
+
+#include "deque.hpp"
+
+std::default_random_engine randnum(time(NULL));
+
+static const int MAX_N = 5000;
+
+typedef sjtu::deque<int, sjtu::deque_policy<64, 1, 4, 1> > SmallDeque;
+typedef sjtu::deque<std::string, sjtu::deque_policy<64, 1, 4, 0> > SmallStrDeque;
+
+// leaves blocks of uneven sizes, so that the segments do not line up with whole blocks.
+template <typename Ans, typename Test>
+void unevenFill(Ans &ans, Test &test) {
+    for (int i = 0; i < MAX_N; i++) {
+        int x = randnum();
+        if (i % 3 == 0) {
+            ans.push_front(x); test.push_front(x);
+        } else {
+            ans.push_back(x); test.push_back(x);
+        }
+    }
+    for (int i = 0; i < 700; i++) {
+        int pos = randnum() % ans.size();
+        int x = randnum();
+        ans.insert(ans.begin() + pos, x); test.insert(test.begin() + pos, x);
+        pos = randnum() % ans.size();
+        ans.erase(ans.begin() + pos); test.erase(test.begin() + pos);
+    }
+}
+
+template <typename Deque>
+bool segmentTest() {
+    std::deque<int> ans;
+    Deque deq;
+    unevenFill(ans, deq);
+
+    int n = 0, runs = 0;
+    bool ok = true;
+    const Deque &c = deq;
+    c.for_each_segment([&](const int *x, const int *y) {
+        runs++;
+        if (x >= y) ok = false;
+        for (; x != y; ++x, ++n)
+            if (*x != ans[n]) ok = false;
+    });
+    if (!ok || n != ans.size() || runs < 1) return false;
+
+    deq.for_each_segment([](int *x, int *y) {
+        for (; x != y; ++x) *x = *x / 2 + 1;
+    });
+    for (int i = 0; i < ans.size(); i++) ans[i] = ans[i] / 2 + 1;
+    for (int i = 0; i < ans.size(); i++)
+        if (ans[i] != deq[i]) return false;
+
+    Deque empty;
+    runs = 0;
+    empty.for_each_segment([&](int *, int *) { runs++; });
+    return runs == 0 && empty.begin() == empty.end();
+}
+
+template <typename Deque>
+bool walkTest() {
+    std::deque<int> ans;
+    Deque deq;
+    unevenFill(ans, deq);
+
+    int n = 0;
+    for (typename Deque::iterator it = deq.begin(); it != deq.end(); ++it, ++n)
+        if (*it != ans[n]) return false;
+    if (n != ans.size()) return false;
+
+    const Deque &c = deq;
+    typename Deque::const_iterator it = c.cend();
+    while (it != c.cbegin()) {
+        it--;
+        if (*it != ans[--n]) return false;
+    }
+    return n == 0;
+}
+
+template <typename Deque>
+bool stepTest() {
+    std::deque<int> ans;
+    Deque deq;
+    unevenFill(ans, deq);
+
+    typename Deque::iterator x = deq.begin() + 17, y;
+    for (int i = 0; i < 3000; i++) {
+        y = x++;
+        if (x - y != 1 || *y != ans[17 + i] || *x != ans[18 + i]) return false;
+        --x;
+        ++x;
+    }
+
+    typename Deque::const_iterator cx = deq.cbegin(), cy;
+    for (int i = 0; i < 3000; i++) {
+        int step = randnum() % 200;
+        cy = cx;
+        cx = cx + step;
+        if (cx - cy != step || *cx != ans[cx - deq.cbegin()]) return false;
+        if (cx - deq.cbegin() > 4000) cx = deq.cbegin() + randnum() % 100;
+    }
+
+    try {
+        *deq.end();
+        return false;
+    } catch (...) {}
+    return true;
+}
+
+template <typename Deque>
+bool stringTest() {
+    std::deque<std::string> ans;
+    Deque deq;
+    for (int i = 0; i < MAX_N; i++) {
+        std::string x = "s" + std::to_string(randnum());
+        if (i % 3 == 0) {
+            ans.push_front(x); deq.push_front(x);
+        } else {
+            ans.push_back(x); deq.push_back(x);
+        }
+    }
+    for (int i = 0; i < 700; i++) {
+        int pos = randnum() % ans.size();
+        ans.erase(ans.begin() + pos); deq.erase(deq.begin() + pos);
+    }
+
+    int n = 0;
+    bool ok = true;
+    deq.for_each_segment([&](std::string *x, std::string *y) {
+        for (; x != y; ++x, ++n) {
+            if (*x != ans[n]) ok = false;
+            *x += "!";
+        }
+    });
+    if (!ok || n != ans.size()) return false;
+
+    typename Deque::const_iterator it = deq.cend();
+    while (it != deq.cbegin()) {
+        --it;
+        if (*it != ans[--n] + "!") return false;
+    }
+    return true;
+}
+
+int main() {
+    bool (*testFunc[])() = {
+        segmentTest<sjtu::deque<int> >, segmentTest<SmallDeque>,
+        walkTest<sjtu::deque<int> >, walkTest<SmallDeque>,
+        stepTest<sjtu::deque<int> >, stepTest<SmallDeque>,
+        stringTest<sjtu::deque<std::string> >, stringTest<SmallStrDeque>,
+    };
+
+    const char *testMessage[] = {
+        "Testing for_each_segment...", "Testing for_each_segment (small)...",
+        "Testing iterator walks...", "Testing iterator walks (small)...",
+        "Testing iterator steps...", "Testing iterator steps (small)...",
+        "Testing strings...", "Testing strings (small)...",
+    };
+
+    bool error = false;
+    for (int i = 0; i < sizeof(testFunc) / sizeof(testFunc[0]); i++) {
+        printf("%-40s", testMessage[i]);
+        if (testFunc[i]())
+            printf("Passed\n");
+        else {
+            error = true;
+            printf("Failed !!!\n");
+        }
+    }
+
+    if (error)
+        printf("\nUnfortunately, you failed in this test\n\a");
+    else
+        printf("\nCongratulations, your deque passed all the tests!\n");
+
+    return 0;
+}
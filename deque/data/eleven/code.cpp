@@ -0,0 +1,58 @@
+#include "deque.hpp"
+
+#include <iostream>
+#include <cstdlib>
+#include <string>
+#include <deque>
+
+template<class T, class D>
+bool isEqual(const std::deque<T> &a, const D &b)
+{
+	if (a.size() != b.size()) return false;
+	for (size_t i = 0; i < a.size(); ++i) {
+		if (!(a[i] == b[i])) return false;
+	}
+	return true;
+}
+
+template<class Policy>
+void TestSelfInsert(const char *name)
+{
+	typedef sjtu::deque<std::string, Policy> Deque;
+	std::cout << "Testing insertion of own elements " << name << "..." << std::endl;
+	std::deque<std::string> a;
+	Deque b;
+	for (int i = 0; i < 100; ++i) {
+		a.push_back("element " + std::to_string(i));
+		b.push_back("element " + std::to_string(i));
+	}
+	a.insert(a.begin() + 50, a[70]);
+	b.insert(b.begin() + 50, b[70]);
+	std::cout << b[50] << std::endl;
+	a.insert(a.begin() + 10, a[5]);
+	b.insert(b.begin() + 10, b[5]);
+	std::cout << b[10] << std::endl;
+	a.emplace(a.begin() + 30, a[31]);
+	b.emplace(b.begin() + 30, b[31]);
+	std::cout << b[30] << std::endl;
+	srand(6);
+	for (int i = 0; i < 3000; ++i) {
+		int x = rand() % (a.size() + 1), y = rand() % a.size();
+		a.insert(a.begin() + x, a[y]);
+		b.insert(b.begin() + x, b[y]);
+		y = rand() % a.size();
+		a.push_back(a[y]);
+		b.push_back(b[y]);
+		a.push_front(a[y]);
+		b.push_front(b[y]);
+	}
+	std::cout << (isEqual(a, b) ? "PASSED" : "FAILED") << std::endl;
+}
+
+int main()
+{
+	TestSelfInsert<sjtu::deque_policy<> >("in default blocks");
+	TestSelfInsert<sjtu::deque_policy<64, 1, 4, 1> >("in small blocks");
+	TestSelfInsert<sjtu::deque_policy<256, 1, 4, 0> >("in mid-sized blocks");
+	return 0;
+}
@@ -0,0 +1,203 @@
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <new>
+
+#include "deque.hpp"
+
+static const int MAX_N = 20000;
+
+int alive = 0, budget = -1, allocs = -1;
+
+// operator new fails with bad_alloc once allocs runs out
+void *operator new(size_t n) {
+    if (allocs == 0) throw std::bad_alloc();
+    if (allocs > 0) allocs--;
+    void *p = malloc(n ? n : 1);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+void *operator new[](size_t n) { return operator new(n); }
+void operator delete(void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+void operator delete[](void *p) noexcept { free(p); }
+void operator delete[](void *p, size_t) noexcept { free(p); }
+
+// counts its live copies and throws from its copy constructor once budget runs out
+class Bomb {
+public:
+    int v;
+    Bomb(int v) : v(v) { alive++; }
+    Bomb(const Bomb &other) : v(other.v) {
+        if (budget == 0) throw -1;
+        if (budget > 0) budget--;
+        alive++;
+    }
+    Bomb &operator=(const Bomb &other) { v = other.v; return *this; }
+    ~Bomb() { alive--; }
+};
+
+template <typename Ans, typename Test>
+bool isEqual(Ans &ans, Test &test) {
+    if (ans.size() != test.size())
+        return false;
+    for (int i = 0; i < ans.size(); i++)
+        if (ans[i] != test[i].v) return false;
+    return true;
+}
+
+template <typename Deque>
+void fill(std::deque<int> &ans, Deque &deq, int n) {
+    for (int i = 0; i < n; i++) {
+        if (i % 3) {
+            ans.push_back(i); deq.push_back(Bomb(i));
+        } else {
+            ans.push_front(i); deq.push_front(Bomb(i));
+        }
+    }
+}
+
+bool copyConstructTest() {
+    {
+        std::deque<int> ans;
+        sjtu::deque<Bomb> deq;
+        fill(ans, deq, MAX_N);
+        int before = alive;
+        for (int k = 0; k < 10; k++) {
+            budget = k * 1999;
+            try {
+                sjtu::deque<Bomb> copy(deq);
+                budget = -1;
+                return false;
+            } catch (int) {}
+            budget = -1;
+            if (alive != before || !isEqual(ans, deq)) return false;
+        }
+    }
+    return alive == 0;
+}
+
+bool copyAssignTest() {
+    {
+        std::deque<int> ans, ans2;
+        sjtu::deque<Bomb> deq, deq2;
+        fill(ans, deq, MAX_N);
+        fill(ans2, deq2, 1000);
+        for (int k = 0; k < 10; k++) {
+            budget = k * 1999;
+            try {
+                deq2 = deq;
+                budget = -1;
+                return false;
+            } catch (int) {}
+            budget = -1;
+            if (!isEqual(ans2, deq2) || !isEqual(ans, deq)) return false;
+        }
+        deq2.push_back(Bomb(-1)); ans2.push_back(-1);
+        deq2.pop_front(); ans2.pop_front();
+        if (!isEqual(ans2, deq2)) return false;
+        deq2 = deq;
+        if (!isEqual(ans, deq2)) return false;
+    }
+    return alive == 0;
+}
+
+bool emptyCopyTest() {
+    {
+        sjtu::deque<Bomb> deq, moved;
+        moved.push_back(Bomb(1));
+        sjtu::deque<Bomb> other(std::move(moved));
+        budget = 0;
+        sjtu::deque<Bomb> a(deq), b(moved);
+        a = moved;
+        b = deq;
+        budget = -1;
+        if (!a.empty() || !b.empty()) return false;
+        a.push_back(Bomb(2));
+        a = deq;
+        if (!a.empty() || other.size() != 1) return false;
+    }
+    return alive == 0;
+}
+
+bool shrinkTest() {
+    {
+        std::deque<int> ans;
+        sjtu::deque<Bomb> deq;
+        fill(ans, deq, MAX_N);
+        for (int i = 0; i < MAX_N - 100; i++) {
+            ans.pop_back(); deq.pop_back();
+        }
+        for (int k = 0; k < 2; k++) {
+            allocs = k;
+            try {
+                deq.shrink_to_fit();
+                allocs = -1;
+                return false;
+            } catch (std::bad_alloc &) {}
+            allocs = -1;
+            if (!isEqual(ans, deq)) return false;
+            deq.push_front(Bomb(k)); ans.push_front(k);
+        }
+        deq.shrink_to_fit();
+        if (!isEqual(ans, deq)) return false;
+    }
+    return alive == 0;
+}
+
+bool splitTest() {
+    {
+        std::deque<int> ans;
+        sjtu::deque<Bomb> deq;
+        fill(ans, deq, MAX_N);
+        int pos = MAX_N / 2 + 7;
+        for (int k = 0; k < 5; k++) {
+            allocs = k;
+            try {
+                sjtu::deque<Bomb> back = deq.split_at(pos);
+                allocs = -1;
+                return false;
+            } catch (std::bad_alloc &) {}
+            allocs = -1;
+            if (!isEqual(ans, deq)) return false;
+        }
+        sjtu::deque<Bomb> back = deq.split_at(pos);
+        std::deque<int> ansBack(ans.begin() + pos, ans.end());
+        ans.erase(ans.begin() + pos, ans.end());
+        if (!isEqual(ans, deq) || !isEqual(ansBack, back)) return false;
+    }
+    return alive == 0;
+}
+
+int main() {
+    bool (*testFunc[])() = {
+        copyConstructTest, copyAssignTest, emptyCopyTest, shrinkTest,
+        splitTest,
+    };
+
+    const char *testMessage[] = {
+        "Testing a copy which throws...", "Testing an assignment which throws...",
+        "Testing copies of empty deques...", "Testing shrink_to_fit out of memory...",
+        "Testing split_at out of memory...",
+    };
+
+    bool error = false;
+    for (int i = 0; i < sizeof(testFunc) / sizeof(testFunc[0]); i++) {
+        printf("%-40s", testMessage[i]);
+        if (testFunc[i]())
+            printf("Passed\n");
+        else {
+            error = true;
+            printf("Failed !!!\n");
+        }
+    }
+
+    if (error)
+        printf("\nUnfortunately, you failed in this test\n\a");
+    else
+        printf("\nCongratulations, your deque passed all the tests!\n");
+
+    return 0;
+}
@@ -0,0 +1,102 @@
+#include "deque.hpp"
+
+#include <iostream>
+#include <deque>
+
+template<class F>
+void expectThrow(const char *name, F f)
+{
+	try {
+		f();
+		std::cout << name << " FAILED" << std::endl;
+	} catch (sjtu::invalid_iterator &) {
+		std::cout << name << " PASSED" << std::endl;
+	} catch (...) {
+		std::cout << name << " FAILED" << std::endl;
+	}
+}
+
+void TestChecked()
+{
+	std::cout << "Testing checked iterators..." << std::endl;
+	sjtu::deque<int> a, b;
+	for (int i = 0; i < 1000; ++i) {
+		a.push_back(i);
+		b.push_back(-i);
+	}
+	sjtu::deque<int>::iterator it = a.begin() + 500;
+	sjtu::deque<int>::const_iterator cit = a.cbegin() + 10;
+	std::cout << "fresh iterator " << (*it == 500 && *cit == 10 ? "PASSED" : "FAILED") << std::endl;
+	a.push_back(1000);
+	expectThrow("dereference after push_back", [&]() { *it; });
+	expectThrow("const dereference after push_back", [&]() { *cit; });
+	expectThrow("insert with a stale iterator", [&]() { a.insert(it, 7); });
+	expectThrow("erase with a stale iterator", [&]() { a.erase(it); });
+	expectThrow("insert with an iterator of another deque", [&]() { a.insert(b.begin(), 7); });
+	expectThrow("erase a range of another deque", [&]() { a.erase(b.begin(), b.end()); });
+	expectThrow("distance between two deques", [&]() { a.begin() - b.begin(); });
+	expectThrow("dereference end", [&]() { *a.end(); });
+
+	it = a.begin() + 500;
+	it = a.insert(it, -1);
+	std::cout << "iterator returned by insert " << (*it == -1 && *(it + 1) == 500 ? "PASSED" : "FAILED") << std::endl;
+	it = a.erase(it);
+	std::cout << "iterator returned by erase " << (*it == 500 ? "PASSED" : "FAILED") << std::endl;
+	sjtu::deque<int>::iterator jt = it;
+	a.clear();
+	expectThrow("dereference after clear", [&]() { *jt; });
+	a.push_back(1);
+	std::cout << "begin after clear " << (*a.begin() == 1 ? "PASSED" : "FAILED") << std::endl;
+
+	sjtu::deque<int> big;
+	for (int i = 0; i < 100000; ++i) {
+		big.push_back(i);
+	}
+	sjtu::deque<int>::iterator kt = big.begin() + 90000;
+	sjtu::deque<int>::const_iterator ckt = big.cbegin() + 90000;
+	big.clear();
+	expectThrow("move a stale iterator", [&]() { kt + 1; });
+	expectThrow("move a stale iterator back", [&]() { kt -= 1; });
+	expectThrow("step a stale iterator back", [&]() { --kt; });
+	expectThrow("move a stale const_iterator", [&]() { ckt + 1; });
+	expectThrow("step a stale const_iterator back", [&]() { ckt--; });
+	expectThrow("move a default iterator", [&]() { sjtu::deque<int>::iterator() + 1; });
+}
+
+void TestUnchecked()
+{
+	std::cout << "Testing unchecked iterators..." << std::endl;
+	typedef sjtu::deque<long long, sjtu::deque_policy<64, 1, 2, 4, false> > Deque;
+	std::deque<long long> a;
+	Deque b;
+	for (int i = 0; i < 3000; ++i) {
+		a.push_back(i);
+		b.push_back(i);
+	}
+	for (int i = 0; i < 1000; ++i) {
+		int p = (i * 7919) % a.size();
+		a.insert(a.begin() + p, -i);
+		Deque::iterator it = b.insert(b.begin() + p, -i);
+		if (*it != -i) std::cout << "insert FAILED" << std::endl;
+		p = (i * 104729) % a.size();
+		a.erase(a.begin() + p);
+		b.erase(b.begin() + p);
+	}
+	a.erase(a.begin() + 100, a.begin() + 600);
+	b.erase(b.begin() + 100, b.begin() + 600);
+	bool ok = a.size() == b.size();
+	size_t n = 0;
+	for (Deque::iterator it = b.begin(); it != b.end(); ++it, ++n)
+		if (*it != a[n]) ok = false;
+	for (Deque::const_iterator it = b.cend(); it != b.cbegin();)
+		if (*--it != a[--n]) ok = false;
+	std::cout << "unchecked deque " << (ok && n == 0 ? "PASSED" : "FAILED") << std::endl;
+	std::cout << b.end() - b.begin() << std::endl;
+}
+
+int main()
+{
+	TestChecked();
+	TestUnchecked();
+	return 0;
+}
@@ -0,0 +1,200 @@
+#include <iostream>
+#include <ctime>
+#include <vector>
+#include <deque>
+#include <string>
+#include <random>
+
+#include "deque.hpp"
+
+std::default_random_engine randnum(time(NULL));
+
+static const int MAX_N = 3000;
+
+typedef sjtu::deque<int, sjtu::deque_policy<64, 1, 4, 1> > SmallDeque;
+typedef sjtu::deque<std::string, sjtu::deque_policy<64, 1, 4, 0> > SmallStrDeque;
+
+template <typename Ans, typename Test>
+bool isEqual(Ans &ans, Test &test) {
+    if (ans.size() != test.size())
+        return false;
+
+    if (ans.empty()) return test.empty() && test.cbegin() == test.cend();
+
+    for (int i = 0; i < ans.size(); i++)
+        if (ans[i] != test[i]) return false;
+
+    typename Test::const_iterator it = test.cbegin();
+    for (int i = 0; i < ans.size(); i++, ++it)
+        if (ans[i] != *it) return false;
+
+    return it == test.cend() && test.cend() - test.cbegin() == ans.size();
+}
+
+// leaves blocks of uneven sizes for split_at and splice_back to cut through.
+template <typename Ans, typename Test>
+void unevenFill(Ans &ans, Test &test, int n = MAX_N) {
+    for (int i = 0; i < n; i++) {
+        int x = randnum();
+        switch (randnum() % 4) {
+        case 0:
+            ans.push_front(x); test.push_front(x);
+            break;
+        case 1: {
+            int pos = randnum() % (ans.size() + 1);
+            ans.insert(ans.begin() + pos, x); test.insert(test.begin() + pos, x);
+            break;
+        }
+        case 2:
+            if (!ans.empty()) {
+                int pos = randnum() % ans.size();
+                ans.erase(ans.begin() + pos); test.erase(test.begin() + pos);
+                break;
+            }
+            // an empty deque gets a push_back instead
+        default:
+            ans.push_back(x); test.push_back(x);
+        }
+    }
+}
+
+template <typename Deque>
+bool splitTest() {
+    std::deque<int> ans;
+    Deque deq;
+    unevenFill(ans, deq);
+
+    for (int i = 0; i < 50; i++) {
+        int pos = randnum() % (ans.size() + 1);
+        Deque back = deq.split_at(pos);
+        std::deque<int> ansBack(ans.begin() + pos, ans.end());
+        ans.erase(ans.begin() + pos, ans.end());
+        if (!isEqual(ans, deq) || !isEqual(ansBack, back)) return false;
+        deq.splice_back(std::move(back));
+        ans.insert(ans.end(), ansBack.begin(), ansBack.end());
+        if (!back.empty() || !isEqual(ans, deq)) return false;
+    }
+
+    Deque all = deq.split_at(0);
+    if (!deq.empty() || !isEqual(ans, all)) return false;
+    Deque none = all.split_at(all.size());
+    if (!none.empty() || !isEqual(ans, all)) return false;
+
+    try {
+        all.split_at(all.size() + 1);
+        return false;
+    } catch (...) {}
+    return isEqual(ans, all);
+}
+
+template <typename Deque>
+bool spliceTest() {
+    std::deque<int> ans, ans2;
+    Deque deq, deq2;
+    unevenFill(ans, deq);
+
+    deq2.splice_back(std::move(deq));
+    ans2.swap(ans);
+    if (!deq.empty() || !isEqual(ans2, deq2)) return false;
+
+    deq.splice_back(std::move(deq));
+    deq.push_back(7); ans.push_back(7);
+    deq2.splice_back(std::move(deq));
+    ans2.push_back(7); ans.clear();
+    if (!isEqual(ans, deq) || !isEqual(ans2, deq2)) return false;
+
+    for (int i = 0; i < 100; i++) {
+        unevenFill(ans, deq, 200);
+        deq2.splice_back(std::move(deq));
+        ans2.insert(ans2.end(), ans.begin(), ans.end());
+        ans.clear();
+        ans2.pop_front(); deq2.pop_front();
+    }
+    if (!isEqual(ans2, deq2)) return false;
+
+    for (int i = 0; i < 1000; i++) {
+        int pos = randnum() % ans2.size(), x = randnum();
+        if ((deq2.begin() + pos) - (deq2.end() - 300) != (ans2.begin() + pos) - (ans2.end() - 300)) return false;
+        ans2.insert(ans2.begin() + pos, x); deq2.insert(deq2.begin() + pos, x);
+        ans2.pop_back(); deq2.pop_back();
+    }
+    return isEqual(ans2, deq2);
+}
+
+template <typename Deque>
+bool shrinkTest() {
+    std::deque<int> ans;
+    Deque deq;
+    deq.shrink_to_fit();
+    unevenFill(ans, deq);
+
+    for (int i = 0; i < 20; i++) {
+        deq.shrink_to_fit();
+        if (!isEqual(ans, deq)) return false;
+        for (int j = 0; j < 200; j++) {
+            int x = randnum();
+            ans.push_front(x); deq.push_front(x);
+            ans.pop_back(); deq.pop_back();
+        }
+        unevenFill(ans, deq, 100);
+    }
+    return isEqual(ans, deq);
+}
+
+template <typename Deque>
+bool stringTest() {
+    std::deque<std::string> ans;
+    Deque deq;
+    for (int i = 0; i < MAX_N; i++) {
+        std::string x = "s" + std::to_string(randnum());
+        ans.push_back(x); deq.push_back(x);
+    }
+
+    for (int i = 0; i < 50; i++) {
+        int pos = randnum() % (ans.size() + 1);
+        Deque back = deq.split_at(pos);
+        std::deque<std::string> ansBack(ans.begin() + pos, ans.end());
+        ans.erase(ans.begin() + pos, ans.end());
+        if (!isEqual(ans, deq) || !isEqual(ansBack, back)) return false;
+        back.splice_back(std::move(deq));
+        ansBack.insert(ansBack.end(), ans.begin(), ans.end());
+        deq = std::move(back);
+        ans.swap(ansBack);
+    }
+    deq.shrink_to_fit();
+    return isEqual(ans, deq);
+}
+
+int main() {
+    bool (*testFunc[])() = {
+        splitTest<sjtu::deque<int> >, splitTest<SmallDeque>,
+        spliceTest<sjtu::deque<int> >, spliceTest<SmallDeque>,
+        shrinkTest<sjtu::deque<int> >, shrinkTest<SmallDeque>,
+        stringTest<sjtu::deque<std::string> >, stringTest<SmallStrDeque>,
+    };
+
+    const char *testMessage[] = {
+        "Testing split_at...", "Testing split_at (small)...",
+        "Testing splice_back...", "Testing splice_back (small)...",
+        "Testing shrink_to_fit...", "Testing shrink_to_fit (small)...",
+        "Testing strings...", "Testing strings (small)...",
+    };
+
+    bool error = false;
+    for (int i = 0; i < sizeof(testFunc) / sizeof(testFunc[0]); i++) {
+        printf("%-40s", testMessage[i]);
+        if (testFunc[i]())
+            printf("Passed\n");
+        else {
+            error = true;
+            printf("Failed !!!\n");
+        }
+    }
+
+    if (error)
+        printf("\nUnfortunately, you failed in this test\n\a");
+    else
+        printf("\nCongratulations, your deque passed all the tests!\n");
+
+    return 0;
+}
@@ -0,0 +1,112 @@
+#include "deque.hpp"
+
+#include <iostream>
+#include <string>
+#include <type_traits>
+
+struct Item {
+	static int copies;
+	int v;
+	Item(int v) : v(v) {}
+	Item(int a, int b) : v(a * b) {}
+	Item(const Item &o) : v(o.v) { ++copies; }
+	Item(Item &&o) noexcept : v(o.v) { o.v = -1; }
+	Item &operator=(const Item &o) { v = o.v; ++copies; return *this; }
+	Item &operator=(Item &&o) noexcept { v = o.v; o.v = -1; return *this; }
+};
+int Item::copies = 0;
+
+template<class D>
+void print(const D &d)
+{
+	for (typename D::const_iterator it = d.cbegin(); it != d.cend(); ++it) {
+		std::cout << it->v << " ";
+	}
+	std::cout << std::endl;
+}
+
+template<class Policy>
+void TestMove(const char *name)
+{
+	typedef sjtu::deque<Item, Policy> Deque;
+	std::cout << "Testing move semantics " << name << "..." << std::endl;
+	Item::copies = 0;
+	Deque a;
+	for (int i = 0; i < 10; ++i) {
+		a.push_back(Item(i));
+		a.push_front(Item(-i));
+	}
+	Item x(100), y(200);
+	a.push_back(std::move(x));
+	a.insert(a.begin() + 5, std::move(y));
+	a.emplace_back(3, 4);
+	a.emplace_front(50);
+	typename Deque::iterator it = a.emplace(a.begin() + 10, 6, 7);
+	std::cout << it->v << " " << x.v << " " << y.v << std::endl;
+	print(a);
+
+	Deque b(std::move(a));
+	std::cout << a.size() << " " << b.size() << std::endl;
+	a.push_back(Item(1));
+	Deque c;
+	c.emplace_back(9);
+	c = std::move(b);
+	std::cout << b.size() << " " << c.size() << " " << c.front().v << " " << c.back().v << std::endl;
+	c = std::move(c);
+	print(a);
+	print(c);
+	for (int i = 0; i < 300; ++i) {
+		c.emplace(c.begin() + c.size() / 2, i);
+	}
+	std::cout << c.size() << " " << c[c.size() / 2].v << " " << Item::copies << std::endl;
+}
+
+// a moved-from deque owns no memory and takes every operation again.
+void TestMovedFrom()
+{
+	typedef sjtu::deque<std::string> Deque;
+	std::cout << std::is_nothrow_move_constructible<Deque>::value << std::is_nothrow_move_assignable<Deque>::value << std::endl;
+	Deque a, e;
+	for (int i = 0; i < 5000; ++i) {
+		a.push_back(std::to_string(i));
+	}
+	Deque b(std::move(a));
+	std::cout << a.size() << " " << a.empty() << " " << (a.begin() == a.end()) << " " << b.size() << std::endl;
+	try {
+		a.pop_front();
+	} catch (...) {
+		std::cout << "pop_front on a moved-from deque throws" << std::endl;
+	}
+	Deque c(a);
+	c = a;
+	a.shrink_to_fit();
+	a.insert(a.begin(), "x");
+	a.emplace_front("w");
+	a.push_back("y");
+	a.append(b.begin(), b.begin() + 3);
+	for (Deque::const_iterator it = a.cbegin(); it != a.cend(); ++it) {
+		std::cout << *it << " ";
+	}
+	std::cout << c.size() << std::endl;
+	e = std::move(a);
+	a = std::move(c);
+	a.insert(a.end(), 2, "z");
+	b.erase(b.begin(), b.end());
+	std::cout << a.size() << " " << a[1] << " " << e.size() << " " << b.size() << std::endl;
+}
+
+int main()
+{
+	TestMove<sjtu::deque_policy<> >("in default blocks");
+	TestMove<sjtu::deque_policy<64, 1, 4, 1> >("in small blocks");
+	sjtu::deque<std::string> s;
+	std::string t(40, 'z');
+	s.push_back(std::move(t));
+	s.emplace_front(3, 'a');
+	s.emplace(s.begin() + 1, "mid");
+	for (size_t i = 0; i < s.size(); ++i) {
+		std::cout << s[i] << std::endl;
+	}
+	TestMovedFrom();
+	return 0;
+}
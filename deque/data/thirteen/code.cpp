@@ -0,0 +1,261 @@
+#include <iostream>
+#include <ctime>
+#include <vector>
+#include <deque>
+#include <string>
+#include <sstream>
+#include <iterator>
+#include <random>
+
+#include "deque.hpp"
+
+std::default_random_engine randnum(time(NULL));
+
+static const int MAX_N = 3000;
+
+typedef sjtu::deque<int, sjtu::deque_policy<64, 1, 4, 1> > SmallDeque;
+typedef sjtu::deque<std::string, sjtu::deque_policy<64, 1, 4, 0> > SmallStrDeque;
+
+template <typename Ans, typename Test>
+bool isEqual(Ans &ans, Test &test) {
+    if (ans.size() != test.size())
+        return false;
+
+    if (ans.empty()) return test.empty() && test.cbegin() == test.cend();
+
+    for (int i = 0; i < ans.size(); i++)
+        if (ans[i] != test[i]) return false;
+
+    typename Test::const_iterator it = test.cbegin();
+    for (int i = 0; i < ans.size(); i++, ++it)
+        if (ans[i] != *it) return false;
+
+    return it == test.cend() && test.cend() - test.cbegin() == ans.size();
+}
+
+template <typename Ans, typename Test>
+void randnumFill(Ans &ans, Test &test, int n = MAX_N) {
+    for (int i = 0; i < n; i++) {
+        int x = randnum();
+        if (randnum() % 2) {
+            ans.push_back(x);
+            test.push_back(x);
+        } else {
+            ans.push_front(x);
+            test.push_front(x);
+        }
+    }
+}
+
+template <typename Deque>
+bool rangeInsertTest() {
+    std::vector<int> src;
+    for (int i = 0; i < MAX_N; i++) src.push_back(randnum());
+    std::deque<int> ans;
+    Deque deq;
+    randnumFill(ans, deq, 2000);
+
+    typename Deque::iterator it = deq.insert(deq.begin() + 777, src.begin(), src.begin() + 500);
+    ans.insert(ans.begin() + 777, src.begin(), src.begin() + 500);
+    if (!isEqual(ans, deq) || it - deq.begin() != 777 || *it != src[0]) return false;
+
+    it = deq.insert(deq.begin() + 9, src.begin(), src.begin());
+    if (!isEqual(ans, deq) || it - deq.begin() != 9) return false;
+
+    for (int i = 0; i < 200; i++) {
+        int pos = randnum() % (ans.size() + 1);
+        int x = randnum() % MAX_N, y = x + randnum() % (MAX_N - x + 1) / (i % 10 ? 50 : 1);
+        it = deq.insert(deq.begin() + pos, src.begin() + x, src.begin() + y);
+        ans.insert(ans.begin() + pos, src.begin() + x, src.begin() + y);
+        if (it - deq.begin() != pos) return false;
+        if (ans.size() > 20000) {
+            ans.erase(ans.begin() + 100, ans.end());
+            deq.erase(deq.begin() + 100, deq.end());
+        }
+    }
+    return isEqual(ans, deq);
+}
+
+template <typename Deque>
+bool fillInsertTest() {
+    std::deque<int> ans;
+    Deque deq;
+    randnumFill(ans, deq, 2000);
+
+    deq.insert(deq.begin() + 1234, 300, -1);
+    ans.insert(ans.begin() + 1234, 300, -1);
+    if (!isEqual(ans, deq)) return false;
+
+    deq.insert(deq.begin() + 20, 3, deq[21]);
+    ans.insert(ans.begin() + 20, 3, ans[21]);
+    if (!isEqual(ans, deq)) return false;
+
+    typename Deque::iterator it = deq.insert(deq.begin() + 7, 0, -2);
+    return isEqual(ans, deq) && it - deq.begin() == 7;
+}
+
+template <typename Deque>
+bool rangeEraseTest() {
+    std::deque<int> ans;
+    Deque deq;
+    randnumFill(ans, deq);
+
+    typename Deque::iterator it = deq.erase(deq.begin() + 10, deq.begin() + 1010);
+    ans.erase(ans.begin() + 10, ans.begin() + 1010);
+    if (!isEqual(ans, deq) || it - deq.begin() != 10 || *it != ans[10]) return false;
+
+    it = deq.erase(deq.begin() + 1500, deq.end());
+    ans.erase(ans.begin() + 1500, ans.end());
+    if (!isEqual(ans, deq) || it != deq.end()) return false;
+
+    deq.erase(deq.begin() + 50, deq.begin() + 50);
+    if (!isEqual(ans, deq)) return false;
+
+    for (int i = 0; i < 200 && !ans.empty(); i++) {
+        int x = randnum() % ans.size(), y = x + randnum() % (ans.size() - x) / 20 + 1;
+        deq.erase(deq.begin() + x, deq.begin() + y);
+        ans.erase(ans.begin() + x, ans.begin() + y);
+        ans.push_front(i); deq.push_front(i);
+    }
+    if (!isEqual(ans, deq)) return false;
+
+    deq.erase(deq.begin(), deq.end());
+    ans.clear();
+    if (!isEqual(ans, deq)) return false;
+    deq.insert(deq.begin(), 10, 5);
+    ans.insert(ans.begin(), 10, 5);
+    return isEqual(ans, deq);
+}
+
+template <typename Deque>
+bool streamTest() {
+    std::deque<int> ans;
+    Deque deq;
+    randnumFill(ans, deq, 1000);
+
+    std::ostringstream out;
+    for (int i = 0; i < 500; i++) out << i << ' ';
+    int pos[] = {0, 333, (int)ans.size() + 500, (int)ans.size() + 1500};
+    for (int t = 0; t < 4; t++) {
+        std::istringstream in(out.str());
+        typename Deque::iterator it = deq.insert(deq.begin() + pos[t], std::istream_iterator<int>(in), std::istream_iterator<int>());
+        for (int i = 0; i < 500; i++) ans.insert(ans.begin() + pos[t] + i, i);
+        if (!isEqual(ans, deq) || it - deq.begin() != pos[t] || *it != 0) return false;
+    }
+
+    std::istringstream in("");
+    typename Deque::iterator it = deq.insert(deq.begin() + 5, std::istream_iterator<int>(in), std::istream_iterator<int>());
+    return isEqual(ans, deq) && it - deq.begin() == 5;
+}
+
+template <typename Deque>
+bool stringTest() {
+    std::vector<std::string> src;
+    for (int i = 0; i < MAX_N; i++) src.push_back("s" + std::to_string(randnum()));
+    std::deque<std::string> ans(src.begin(), src.begin() + 1000);
+    Deque deq;
+    deq.append(src.begin(), src.begin() + 1000);
+
+    for (int i = 0; i < 100; i++) {
+        int pos = randnum() % (ans.size() + 1), x = randnum() % (MAX_N - 100);
+        deq.insert(deq.begin() + pos, src.begin() + x, src.begin() + x + 100);
+        ans.insert(ans.begin() + pos, src.begin() + x, src.begin() + x + 100);
+        x = randnum() % (ans.size() - 50);
+        deq.erase(deq.begin() + x, deq.begin() + x + 50);
+        ans.erase(ans.begin() + x, ans.begin() + x + 50);
+    }
+    return isEqual(ans, deq);
+}
+
+int alive = 0, budget = -1;
+
+// counts its live copies and throws from its copy constructor once budget runs out,
+// moving one never throws
+class Bomb {
+public:
+    int v;
+    Bomb(int v) : v(v) { alive++; }
+    Bomb(const Bomb &other) : v(other.v) {
+        if (budget == 0) throw -1;
+        if (budget > 0) budget--;
+        alive++;
+    }
+    Bomb(Bomb &&other) noexcept : v(other.v) { alive++; }
+    Bomb &operator=(const Bomb &other) { v = other.v; return *this; }
+    ~Bomb() { alive--; }
+    bool operator!=(const Bomb &rhs) const { return v != rhs.v; }
+};
+
+template <typename Deque>
+bool throwTest() {
+    {
+        std::vector<Bomb> src;
+        for (int i = 0; i < MAX_N; i++) src.push_back(Bomb(i));
+        std::deque<Bomb> ans(src.begin(), src.begin() + 1000);
+        Deque deq(src.begin(), src.begin() + 1000);
+        for (int k = 0; k < 8; k++) {
+            int pos = randnum() % (ans.size() + 1);
+            budget = k * 300;
+            try {
+                deq.insert(deq.begin() + pos, src.begin(), src.end());
+                return false;
+            } catch (int) {}
+            budget = -1;
+            if (!isEqual(ans, deq)) return false;
+            budget = k * 7;
+            try {
+                deq.insert(deq.begin() + pos, 100, src[k]);
+                return false;
+            } catch (int) {}
+            budget = -1;
+            if (!isEqual(ans, deq)) return false;
+        }
+        std::istringstream in("1 2 3 4 5 6 7");
+        deq.insert(deq.begin() + 500, std::istream_iterator<int>(in), std::istream_iterator<int>());
+        for (int i = 1; i <= 7; i++) ans.insert(ans.begin() + 499 + i, Bomb(i));
+        for (int i = 0; i < MAX_N; i++) {
+            ans.push_front(Bomb(i)); deq.push_front(Bomb(i));
+            ans.erase(ans.begin() + 700); deq.erase(deq.begin() + 700);
+        }
+        if (!isEqual(ans, deq)) return false;
+    }
+    return alive == 0;
+}
+
+int main() {
+    bool (*testFunc[])() = {
+        rangeInsertTest<sjtu::deque<int> >, rangeInsertTest<SmallDeque>,
+        fillInsertTest<sjtu::deque<int> >, fillInsertTest<SmallDeque>,
+        rangeEraseTest<sjtu::deque<int> >, rangeEraseTest<SmallDeque>,
+        streamTest<sjtu::deque<int> >, streamTest<SmallDeque>,
+        stringTest<sjtu::deque<std::string> >, stringTest<SmallStrDeque>,
+        throwTest<sjtu::deque<Bomb> >, throwTest<sjtu::deque<Bomb, sjtu::deque_policy<64, 1, 4, 1> > >,
+    };
+
+    const char *testMessage[] = {
+        "Testing range insert...", "Testing range insert (small)...",
+        "Testing fill insert...", "Testing fill insert (small)...",
+        "Testing range erase...", "Testing range erase (small)...",
+        "Testing single-pass ranges...", "Testing single-pass ranges (small)...",
+        "Testing strings...", "Testing strings (small)...",
+        "Testing a throwing insert...", "Testing a throwing insert (small)...",
+    };
+
+    bool error = false;
+    for (int i = 0; i < sizeof(testFunc) / sizeof(testFunc[0]); i++) {
+        printf("%-40s", testMessage[i]);
+        if (testFunc[i]())
+            printf("Passed\n");
+        else {
+            error = true;
+            printf("Failed !!!\n");
+        }
+    }
+
+    if (error)
+        printf("\nUnfortunately, you failed in this test\n\a");
+    else
+        printf("\nCongratulations, your deque passed all the tests!\n");
+
+    return 0;
+}
@@ -0,0 +1,262 @@
+#include <iostream>
+#include <ctime>
+#include <vector>
+#include <list>
+#include <deque>
+#include <string>
+#include <sstream>
+#include <iterator>
+#include <random>
+
+#include "deque.hpp"
+
+std::default_random_engine randnum(time(NULL));
+
+static const int MAX_N = 3000;
+
+typedef sjtu::deque<int, sjtu::deque_policy<64, 1, 4, 1> > SmallDeque;
+typedef sjtu::deque<std::string, sjtu::deque_policy<64, 1, 4, 0> > SmallStrDeque;
+
+template <typename Ans, typename Test>
+bool isEqual(Ans &ans, Test &test) {
+    if (ans.size() != test.size())
+        return false;
+
+    if (ans.empty()) return test.empty() && test.cbegin() == test.cend();
+
+    for (int i = 0; i < ans.size(); i++)
+        if (ans[i] != test[i]) return false;
+
+    typename Test::const_iterator it = test.cbegin();
+    for (int i = 0; i < ans.size(); i++, ++it)
+        if (ans[i] != *it) return false;
+
+    return it == test.cend() && test.cend() - test.cbegin() == ans.size();
+}
+
+std::vector<int> randnumSource(int n = MAX_N) {
+    std::vector<int> src;
+    for (int i = 0; i < n; i++) src.push_back(randnum());
+    return src;
+}
+
+template <typename Deque>
+bool rangeConstructTest() {
+    std::vector<int> src = randnumSource();
+    std::list<int> l(src.begin() + 7, src.begin() + 107);
+
+    std::deque<int> ans(src.begin(), src.begin() + 1000), ans2(l.begin(), l.end()), ans3;
+    Deque deq(src.begin(), src.begin() + 1000), deq2(l.begin(), l.end()), deq3(src.begin(), src.begin());
+    if (!isEqual(ans, deq) || !isEqual(ans2, deq2) || !isEqual(ans3, deq3)) return false;
+
+    Deque deq4(deq), deq5;
+    deq5 = deq;
+    if (!isEqual(ans, deq4) || !isEqual(ans, deq5)) return false;
+
+    for (int i = 0; i < MAX_N; i++) {
+        int x = randnum();
+        if (randnum() % 2) {
+            ans.push_front(x); deq.push_front(x);
+        } else {
+            ans.pop_back(); deq.pop_back();
+        }
+        if (ans.empty()) {
+            ans.push_back(x); deq.push_back(x);
+        }
+    }
+    return isEqual(ans, deq);
+}
+
+template <typename Deque>
+bool appendTest() {
+    std::vector<int> src = randnumSource();
+    std::list<int> l(src.begin(), src.begin() + 500);
+    std::deque<int> ans;
+    Deque deq;
+
+    deq.append(src.begin(), src.begin() + 3);
+    ans.insert(ans.end(), src.begin(), src.begin() + 3);
+    if (!isEqual(ans, deq)) return false;
+
+    deq.append(l.begin(), l.end());
+    ans.insert(ans.end(), l.begin(), l.end());
+    if (!isEqual(ans, deq)) return false;
+
+    for (int i = 0; i < 100; i++) {
+        int x = randnum() % MAX_N, y = x + randnum() % (MAX_N - x + 1);
+        deq.append(src.begin() + x, src.begin() + y);
+        ans.insert(ans.end(), src.begin() + x, src.begin() + y);
+        ans.pop_front(); deq.pop_front();
+        ans.push_front(x); deq.push_front(x);
+    }
+    if (!isEqual(ans, deq)) return false;
+
+    deq.append(3, 7); ans.insert(ans.end(), 3, 7);
+    deq.insert(deq.begin() + 1, 3, 7); ans.insert(ans.begin() + 1, 3, 7);
+    deq.append(0, 9);
+    deq.append(1000, deq[5]); ans.insert(ans.end(), 1000, ans[5]);
+    return isEqual(ans, deq);
+}
+
+template <typename Deque>
+bool assignTest() {
+    std::vector<int> src = randnumSource();
+    std::deque<int> ans;
+    Deque deq;
+
+    ans.assign(src.begin() + 100, src.begin() + 2100);
+    deq.assign(src.begin() + 100, src.begin() + 2100);
+    if (!isEqual(ans, deq)) return false;
+
+    ans.assign(src.begin() + 5, src.begin() + 50);
+    deq.assign(src.begin() + 5, src.begin() + 50);
+    if (!isEqual(ans, deq)) return false;
+
+    ans.assign(src.begin(), src.begin());
+    deq.assign(src.begin(), src.begin());
+    if (!isEqual(ans, deq)) return false;
+
+    ans.assign(src.begin(), src.end());
+    deq.assign(src.begin(), src.end());
+    for (int i = 0; i < 1000; i++) {
+        ans.push_front(i); deq.push_front(i);
+        ans.pop_back(); deq.pop_back();
+    }
+    return isEqual(ans, deq);
+}
+
+template <typename Deque>
+bool streamTest() {
+    std::vector<int> src = randnumSource(500);
+    std::ostringstream out;
+    for (int i = 0; i < src.size(); i++) out << src[i] << ' ';
+
+    std::istringstream in(out.str());
+    Deque deq((std::istream_iterator<int>(in)), std::istream_iterator<int>());
+    std::deque<int> ans(src.begin(), src.end());
+    if (!isEqual(ans, deq)) return false;
+
+    std::istringstream in2(out.str());
+    deq.append(std::istream_iterator<int>(in2), std::istream_iterator<int>());
+    ans.insert(ans.end(), src.begin(), src.end());
+    if (!isEqual(ans, deq)) return false;
+
+    std::istringstream in3("1 2 3 4 5");
+    deq.assign(std::istream_iterator<int>(in3), std::istream_iterator<int>());
+    ans.assign({1, 2, 3, 4, 5});
+    if (!isEqual(ans, deq)) return false;
+
+    std::istringstream in4("");
+    deq.assign(std::istream_iterator<int>(in4), std::istream_iterator<int>());
+    ans.clear();
+    return isEqual(ans, deq);
+}
+
+template <typename Deque>
+bool stringTest() {
+    std::vector<std::string> src;
+    for (int i = 0; i < MAX_N; i++) src.push_back("s" + std::to_string(randnum()));
+    std::deque<std::string> ans(src.begin(), src.begin() + 1000);
+    Deque deq(src.begin(), src.begin() + 1000);
+    if (!isEqual(ans, deq)) return false;
+
+    ans.insert(ans.end(), src.begin() + 1000, src.end());
+    deq.append(src.begin() + 1000, src.end());
+    if (!isEqual(ans, deq)) return false;
+
+    std::istringstream in("one two three");
+    deq.append(std::istream_iterator<std::string>(in), std::istream_iterator<std::string>());
+    ans.push_back("one"); ans.push_back("two"); ans.push_back("three");
+    if (!isEqual(ans, deq)) return false;
+
+    ans.assign(src.begin() + 10, src.begin() + 20);
+    deq.assign(src.begin() + 10, src.begin() + 20);
+    return isEqual(ans, deq);
+}
+
+int alive = 0, budget = -1;
+
+// counts its live copies and throws from its copy constructor once budget runs out,
+// moving one never throws
+class Bomb {
+public:
+    int v;
+    Bomb(int v) : v(v) { alive++; }
+    Bomb(const Bomb &other) : v(other.v) {
+        if (budget == 0) throw -1;
+        if (budget > 0) budget--;
+        alive++;
+    }
+    Bomb(Bomb &&other) noexcept : v(other.v) { alive++; }
+    Bomb &operator=(const Bomb &other) { v = other.v; return *this; }
+    ~Bomb() { alive--; }
+    bool operator!=(const Bomb &rhs) const { return v != rhs.v; }
+};
+
+template <typename Deque>
+bool throwTest() {
+    {
+        std::vector<Bomb> src;
+        for (int i = 0; i < MAX_N; i++) src.push_back(Bomb(i));
+        std::istringstream in("1 2 3 4 5 6 7");
+        std::deque<Bomb> ans(src.begin(), src.begin() + 100);
+        Deque deq(src.begin(), src.begin() + 100);
+        for (int k = 0; k < 5; k++) {
+            budget = k * 700;
+            try {
+                deq.append(src.begin(), src.end());
+                return false;
+            } catch (int) {}
+            budget = -1;
+            if (!isEqual(ans, deq)) return false;
+        }
+        budget = 200;
+        try {
+            Deque deq2(src.begin(), src.end());
+            return false;
+        } catch (int) {}
+        budget = -1;
+        deq.append(std::istream_iterator<int>(in), std::istream_iterator<int>());
+        for (int i = 1; i <= 7; i++) ans.push_back(Bomb(i));
+        if (!isEqual(ans, deq)) return false;
+    }
+    return alive == 0;
+}
+
+int main() {
+    bool (*testFunc[])() = {
+        rangeConstructTest<sjtu::deque<int> >, rangeConstructTest<SmallDeque>,
+        appendTest<sjtu::deque<int> >, appendTest<SmallDeque>,
+        assignTest<sjtu::deque<int> >, assignTest<SmallDeque>,
+        streamTest<sjtu::deque<int> >, streamTest<SmallDeque>,
+        stringTest<sjtu::deque<std::string> >, stringTest<SmallStrDeque>,
+        throwTest<sjtu::deque<Bomb> >, throwTest<sjtu::deque<Bomb, sjtu::deque_policy<64, 1, 4, 1> > >,
+    };
+
+    const char *testMessage[] = {
+        "Testing range constructor...", "Testing range constructor (small)...",
+        "Testing append...", "Testing append (small)...",
+        "Testing assign...", "Testing assign (small)...",
+        "Testing single-pass ranges...", "Testing single-pass ranges (small)...",
+        "Testing strings...", "Testing strings (small)...",
+        "Testing a throwing append...", "Testing a throwing append (small)...",
+    };
+
+    bool error = false;
+    for (int i = 0; i < sizeof(testFunc) / sizeof(testFunc[0]); i++) {
+        printf("%-40s", testMessage[i]);
+        if (testFunc[i]())
+            printf("Passed\n");
+        else {
+            error = true;
+            printf("Failed !!!\n");
+        }
+    }
+
+    if (error)
+        printf("\nUnfortunately, you failed in this test\n\a");
+    else
+        printf("\nCongratulations, your deque passed all the tests!\n");
+
+    return 0;
+}
@@ -0,0 +1,116 @@
+#include<iostream>
+#include<map>
+#include<string>
+#include<cstdlib>
+#include<type_traits>
+#include "map.hpp"
+
+using namespace std;
+
+template<class M, class S>
+bool same(M &Q, S &stdQ){
+	if(Q.size() != stdQ.size()) return 0;
+	typename S::iterator stdit = stdQ.begin();
+	for(typename M::iterator it = Q.begin(); it != Q.end(); it++, stdit++){
+		if(stdit -> first != it -> first) return 0;
+		if(stdit -> second != it -> second) return 0;
+	}
+	return 1;
+}
+
+bool check1(){ //insert and erase churn in slabs of two nodes
+	sjtu::map<int, string, std::less<int>, 2> Q;
+	std::map<int, string> stdQ;
+	for(int i = 1; i <= 30000; i++){
+		int a = rand() % 3000;
+		string b = to_string(rand());
+		if(rand() % 2){
+			Q[a] = b; stdQ[a] = b;
+		}else if(Q.count(a)){
+			Q.erase(Q.find(a)); stdQ.erase(a);
+		}
+	}
+	return same(Q, stdQ);
+}
+
+bool check2(){ //clear and refill
+	sjtu::map<int, string, std::less<int>, 8> Q;
+	std::map<int, string> stdQ;
+	for(int round = 0; round < 20; round++){
+		for(int i = 0; i < 500; i++){
+			int a = rand() % 1000;
+			Q[a] = to_string(a); stdQ[a] = to_string(a);
+		}
+		if(!same(Q, stdQ)) return 0;
+		if(round % 3 == 0){
+			Q.clear(); stdQ.clear();
+			if(!Q.empty() || Q.begin() != Q.end()) return 0;
+		}
+	}
+	return same(Q, stdQ);
+}
+
+bool check3(){ //copy, assign and move between maps with their own slabs
+	sjtu::map<int, string, std::less<int>, 4> Q;
+	std::map<int, string> stdQ;
+	for(int i = 0; i < 2000; i++){
+		int a = rand() % 5000;
+		Q[a] = to_string(i); stdQ[a] = to_string(i);
+	}
+	sjtu::map<int, string, std::less<int>, 4> A(Q), B;
+	B = Q;
+	Q.clear();
+	for(int i = 0; i < 100; i++) Q[i] = "x";
+	if(!same(A, stdQ) || !same(B, stdQ)) return 0;
+	sjtu::map<int, string, std::less<int>, 4> C(std::move(A));
+	if(!A.empty() || !same(C, stdQ)) return 0;
+	A = std::move(B);
+	for(int i = 0; i < 1000; i++){
+		int a = rand() % 5000;
+		if(A.count(a)){
+			A.erase(A.find(a)); stdQ.erase(a);
+		}
+	}
+	return same(A, stdQ) && B.empty();
+}
+
+bool check4(){ //references stay put while the slabs grow
+	sjtu::map<int, int> Q;
+	int &first = Q[0];
+	first = 7;
+	for(int i = 1; i <= 10000; i++) Q[i] = i;
+	for(int i = 1; i <= 10000; i += 2) Q.erase(Q.find(i));
+	for(int i = 10001; i <= 15000; i++) Q[i] = i;
+	return first == 7 && &first == &Q[0] && Q.size() == 10001;
+}
+
+bool check5(){ //a moved-from map holds nothing and can be filled again
+	typedef sjtu::map<int, string> M;
+	if(!std::is_nothrow_move_constructible<M>::value || !std::is_nothrow_move_assignable<M>::value) return 0;
+	M Q;
+	std::map<int, string> stdQ;
+	for(int i = 0; i < 300; i++){
+		Q[i * 7 % 300] = to_string(i); stdQ[i * 7 % 300] = to_string(i);
+	}
+	M R(std::move(Q)), E;
+	if(!same(R, stdQ) || !Q.empty() || Q.begin() != Q.end() || Q.count(3) || Q.find(3) != Q.end()) return 0;
+	try{ --Q.end(); return 0; }catch(...){}
+	M P(Q);
+	P = Q;
+	if(!P.empty()) return 0;
+	Q = std::move(E);
+	for(int i = 0; i < 50; i++) Q[i] = "y";
+	E = std::move(Q);
+	E.erase(E.find(10));
+	return same(R, stdQ) && E.size() == 49 && Q.empty() && Q.lower_bound(0) == Q.end();
+}
+
+int main(){
+	srand(20);
+	if(!check1()) cout << "Test 1 Failed......" << endl; else cout << "Test 1 Passed!" << endl;
+	if(!check2()) cout << "Test 2 Failed......" << endl; else cout << "Test 2 Passed!" << endl;
+	if(!check3()) cout << "Test 3 Failed......" << endl; else cout << "Test 3 Passed!" << endl;
+	if(!check4()) cout << "Test 4 Failed......" << endl; else cout << "Test 4 Passed!" << endl;
+	if(!check5()) cout << "Test 5 Failed......" << endl; else cout << "Test 5 Passed!" << endl;
+	return 0;
+}
@@ -0,0 +1,85 @@
+#include<iostream>
+#include<map>
+#include<string>
+#include<cstdlib>
+#include "map.hpp"
+
+using namespace std;
+
+typedef sjtu::map<int, string> Map;
+typedef sjtu::pair<const int, string> Pair;
+
+bool same(Map &Q, std::map<int, string> &stdQ){
+	if(Q.size() != stdQ.size()) return 0;
+	std::map<int, string>::iterator stdit = stdQ.begin();
+	for(Map::iterator it = Q.begin(); it != Q.end(); it++, stdit++)
+		if(it -> first != stdit -> first || it -> second != stdit -> second) return 0;
+	std::map<int, string>::reverse_iterator rit = stdQ.rbegin();
+	Map::iterator it = Q.end();
+	for(size_t i = 0; i < Q.size(); i++, rit++){
+		it--;
+		if(it -> first != rit -> first) return 0;
+	}
+	return 1;
+}
+
+bool check1(){ //ascending keys at end()
+	Map Q; std::map<int, string> stdQ;
+	for(int i = 0; i < 50000; i++){
+		Map::iterator it = Q.insert(Q.end(), Pair(i * 3, to_string(i)));
+		stdQ[i * 3] = to_string(i);
+		if(it -> first != i * 3 || it != Q.nth(i)) return 0;
+	}
+	for(int i = 0; i < 50000; i += 7) if(Q.rank(i * 3) != (size_t)i) return 0;
+	return same(Q, stdQ);
+}
+
+bool check2(){ //descending keys at begin()
+	Map Q; std::map<int, string> stdQ;
+	for(int i = 30000; i > 0; i--){
+		Q.insert(Q.begin(), Pair(i, to_string(i)));
+		stdQ[i] = to_string(i);
+	}
+	return same(Q, stdQ) && Q.begin() -> first == 1;
+}
+
+bool check3(){ //hints in the middle and wrong hints
+	Map Q; std::map<int, string> stdQ;
+	for(int i = 0; i < 20000; i++){
+		int k = rand() % 50000;
+		Map::iterator h;
+		switch(rand() % 3){
+			case 0: h = Q.lower_bound(k); break;
+			case 1: h = Q.nth(rand() % (Q.size() + 1)); break;
+			default: h = Q.end();
+		}
+		Map::iterator it = Q.insert(h, Pair(k, to_string(i)));
+		stdQ.insert(std::pair<int, string>(k, to_string(i)));
+		if(it -> first != k || it -> second != stdQ[k]) return 0;
+	}
+	return same(Q, stdQ);
+}
+
+bool check4(){ //appending after erasing the tail, and a hint from another map
+	Map Q, P; std::map<int, string> stdQ;
+	for(int i = 0; i < 10000; i++){
+		Q.insert(Q.end(), Pair(i, "a")); stdQ[i] = "a";
+		if(i % 3 == 0){
+			Q.erase(--Q.end()); stdQ.erase(--stdQ.end());
+		}
+	}
+	try{
+		Q.insert(P.end(), Pair(-1, "x"));
+		return 0;
+	}catch(...){}
+	return same(Q, stdQ);
+}
+
+int main(){
+	srand(23);
+	if(!check1()) cout << "Test 1 Failed......" << endl; else cout << "Test 1 Passed!" << endl;
+	if(!check2()) cout << "Test 2 Failed......" << endl; else cout << "Test 2 Passed!" << endl;
+	if(!check3()) cout << "Test 3 Failed......" << endl; else cout << "Test 3 Passed!" << endl;
+	if(!check4()) cout << "Test 4 Failed......" << endl; else cout << "Test 4 Passed!" << endl;
+	return 0;
+}
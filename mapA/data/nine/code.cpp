@@ -0,0 +1,103 @@
+#include<iostream>
+#include<map>
+#include<vector>
+#include<cstdlib>
+#include "map.hpp"
+
+using namespace std;
+
+sjtu::map<int, int> Q;
+std::map<int, int> stdQ;
+
+void build(){
+	for(int i = 1; i <= 20000; i++){
+		int a = rand() % 50000, b = rand();
+		Q[a] = b; stdQ[a] = b;
+	}
+	for(int i = 1; i <= 5000; i++){
+		int a = rand() % 50000;
+		if(Q.count(a)){
+			Q.erase(Q.find(a)); stdQ.erase(a);
+		}
+	}
+}
+
+bool check1(){ //nth
+	vector<int> keys;
+	for(std::map<int, int>::iterator it = stdQ.begin(); it != stdQ.end(); it++) keys.push_back(it -> first);
+	for(size_t i = 0; i < keys.size(); i += 7){
+		sjtu::map<int, int>::iterator it = Q.nth(i);
+		if(it == Q.end() || it -> first != keys[i] || it -> second != stdQ[keys[i]]) return 0;
+	}
+	const sjtu::map<int, int> &C = Q;
+	if(C.nth(keys.size() - 1) -> first != keys.back()) return 0;
+	return Q.nth(keys.size()) == Q.end() && Q.nth(keys.size() + 100) == Q.end();
+}
+
+bool check2(){ //rank
+	for(int i = 0; i < 3000; i++){
+		int a = rand() % 52000 - 1000;
+		size_t r = 0;
+		for(std::map<int, int>::iterator it = stdQ.begin(); it != stdQ.end() && it -> first < a; it++) r++;
+		if(Q.rank(a) != r) return 0;
+	}
+	return Q.rank(-1) == 0 && Q.rank(1000000) == Q.size();
+}
+
+bool check3(){ //iterator arithmetic
+	sjtu::map<int, int>::iterator b = Q.begin(), e = Q.end();
+	if(e - b != (int)Q.size()) return 0;
+	for(int i = 0; i < 2000; i++){
+		int x = rand() % Q.size(), y = rand() % (Q.size() + 1);
+		sjtu::map<int, int>::iterator it = b + x, jt = it + (y - x);
+		if(it - b != x || jt - b != y) return 0;
+		if(jt != Q.nth(y)) return 0;
+		jt -= y - x;
+		if(jt != it) return 0;
+		sjtu::map<int, int>::const_iterator ct = Q.cbegin() + x;
+		if(ct -> first != it -> first || (ct + 1) - ct != 1) return 0;
+	}
+	try{
+		b - 1;
+		return 0;
+	}catch(...){}
+	try{
+		e + 1;
+		return 0;
+	}catch(...){}
+	sjtu::map<int, int> other;
+	try{
+		b - other.begin();
+		return 0;
+	}catch(...){}
+	return 1;
+}
+
+bool check4(){ //percentiles stay right while keys come and go
+	for(int round = 0; round < 50; round++){
+		for(int i = 0; i < 200; i++){
+			int a = rand() % 50000;
+			if(rand() % 3 && Q.count(a)){
+				Q.erase(Q.find(a)); stdQ.erase(a);
+			}else{
+				Q[a] = i; stdQ[a] = i;
+			}
+		}
+		size_t k = Q.size() * (round % 10) / 10;
+		std::map<int, int>::iterator stdit = stdQ.begin();
+		for(size_t i = 0; i < k; i++) stdit++;
+		sjtu::map<int, int>::iterator it = Q.nth(k);
+		if(it -> first != stdit -> first || Q.rank(it -> first) != k) return 0;
+	}
+	return 1;
+}
+
+int main(){
+	srand(21);
+	build();
+	if(!check1()) cout << "Test 1 Failed......" << endl; else cout << "Test 1 Passed!" << endl;
+	if(!check2()) cout << "Test 2 Failed......" << endl; else cout << "Test 2 Passed!" << endl;
+	if(!check3()) cout << "Test 3 Failed......" << endl; else cout << "Test 3 Passed!" << endl;
+	if(!check4()) cout << "Test 4 Failed......" << endl; else cout << "Test 4 Passed!" << endl;
+	return 0;
+}
@@ -0,0 +1,90 @@
+#include<iostream>
+#include<map>
+#include<string>
+#include<cstdlib>
+#include "map.hpp"
+
+using namespace std;
+
+sjtu::map<long long, string> Q;
+std::map<long long, string> stdQ;
+
+void build(){
+	long long t = 0;
+	for(int i = 1; i <= 20000; i++){
+		t += rand() % 10 + 1;
+		Q[t] = to_string(i); stdQ[t] = to_string(i);
+	}
+}
+
+bool check1(){ //lower_bound and upper_bound
+	for(int i = 0; i < 5000; i++){
+		long long k = rand() % 120000 - 1000;
+		sjtu::map<long long, string>::iterator a = Q.lower_bound(k), b = Q.upper_bound(k);
+		std::map<long long, string>::iterator sa = stdQ.lower_bound(k), sb = stdQ.upper_bound(k);
+		if((a == Q.end()) != (sa == stdQ.end())) return 0;
+		if((b == Q.end()) != (sb == stdQ.end())) return 0;
+		if(a != Q.end() && (a -> first != sa -> first || a -> second != sa -> second)) return 0;
+		if(b != Q.end() && b -> first != sb -> first) return 0;
+	}
+	const sjtu::map<long long, string> &C = Q;
+	return C.lower_bound(-5) == C.cbegin() && C.upper_bound(1000000) == C.cend();
+}
+
+bool check2(){ //equal_range
+	for(int i = 0; i < 3000; i++){
+		long long k = rand() % 110000;
+		sjtu::pair<sjtu::map<long long, string>::iterator, sjtu::map<long long, string>::iterator> r = Q.equal_range(k);
+		int n = 0;
+		for(sjtu::map<long long, string>::iterator it = r.first; it != r.second; it++) n++;
+		if(n != (int)stdQ.count(k)) return 0;
+		if(n == 1 && r.first -> first != k) return 0;
+	}
+	return 1;
+}
+
+bool check3(){ //scan a time window
+	for(int i = 0; i < 300; i++){
+		long long lo = rand() % 110000, hi = lo + rand() % 2000;
+		std::map<long long, string>::iterator stdit = stdQ.lower_bound(lo);
+		size_t n = 0;
+		for(sjtu::map<long long, string>::iterator it = Q.lower_bound(lo); it != Q.end() && it -> first < hi; it++, stdit++, n++)
+			if(it -> first != stdit -> first || it -> second != stdit -> second) return 0;
+		if(stdit != stdQ.lower_bound(hi)) return 0;
+		if(Q.count_range(lo, hi) != n) return 0;
+		if(Q.count_range(hi, lo) != 0) return 0;
+	}
+	return Q.count_range(-1, 1000000) == Q.size();
+}
+
+bool check4(){ //bounds after erasing
+	for(int i = 0; i < 5000; i++){
+		long long k = rand() % 110000;
+		sjtu::map<long long, string>::iterator it = Q.lower_bound(k);
+		if(it != Q.end()){
+			stdQ.erase(it -> first);
+			Q.erase(it);
+		}
+	}
+	for(int i = 0; i < 2000; i++){
+		long long lo = rand() % 110000, hi = lo + rand() % 5000;
+		size_t n = 0;
+		for(std::map<long long, string>::iterator it = stdQ.lower_bound(lo); it != stdQ.end() && it -> first < hi; it++) n++;
+		if(Q.count_range(lo, hi) != n) return 0;
+		std::map<long long, string>::iterator sb = stdQ.upper_bound(lo);
+		sjtu::map<long long, string>::iterator b = Q.upper_bound(lo);
+		if((b == Q.end()) != (sb == stdQ.end())) return 0;
+		if(b != Q.end() && b -> first != sb -> first) return 0;
+	}
+	return 1;
+}
+
+int main(){
+	srand(22);
+	build();
+	if(!check1()) cout << "Test 1 Failed......" << endl; else cout << "Test 1 Passed!" << endl;
+	if(!check2()) cout << "Test 2 Failed......" << endl; else cout << "Test 2 Passed!" << endl;
+	if(!check3()) cout << "Test 3 Failed......" << endl; else cout << "Test 3 Passed!" << endl;
+	if(!check4()) cout << "Test 4 Failed......" << endl; else cout << "Test 4 Passed!" << endl;
+	return 0;
+}
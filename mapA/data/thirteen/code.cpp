@@ -0,0 +1,146 @@
+#include<iostream>
+#include<map>
+#include<string>
+#include<cstdlib>
+#include "map.hpp"
+
+using namespace std;
+
+typedef sjtu::map<int, string> Map;
+
+struct Fragile{
+	static int left;
+	int v;
+	Fragile(int v = 0) : v(v) {}
+	Fragile(const Fragile &o) : v(o.v) {
+		if(left >= 0 && left-- == 0) throw 0;
+	}
+};
+int Fragile::left = -1;
+
+Map Q;
+std::map<int, string> stdQ;
+
+bool same(Map &Q, std::map<int, string> &stdQ){
+	if(Q.size() != stdQ.size()) return 0;
+	std::map<int, string>::iterator stdit = stdQ.begin();
+	for(Map::iterator it = Q.begin(); it != Q.end(); it++, stdit++)
+		if(it -> first != stdit -> first || it -> second != stdit -> second) return 0;
+	std::map<int, string>::reverse_iterator rit = stdQ.rbegin();
+	Map::iterator it = Q.end();
+	for(size_t i = 0; i < Q.size(); i++, rit++){
+		it--;
+		if(it -> first != rit -> first) return 0;
+	}
+	return 1;
+}
+
+bool check1(){ //copy a map with holes left by erase
+	for(int i = 0; i < 60000; i++){
+		int k = rand() % 100000;
+		Q[k] = to_string(i); stdQ[k] = to_string(i);
+	}
+	for(int i = 0; i < 40000; i++){
+		int k = rand() % 100000;
+		Map::iterator it = Q.find(k);
+		if(it != Q.end()) Q.erase(it);
+		stdQ.erase(k);
+	}
+	Map P(Q);
+	if(!same(P, stdQ)) return 0;
+	for(int i = 0; i < (int)stdQ.size(); i += 97) if(P.nth(i) -> first != next(stdQ.begin(), i) -> first) return 0;
+	return same(Q, stdQ);
+}
+
+bool check2(){ //the copy is independent and reuses the holes
+	Map P(Q);
+	std::map<int, string> S = stdQ;
+	for(int i = 0; i < 30000; i++){
+		int k = rand() % 100000;
+		if(rand() % 3){
+			P[k] = "p"; S[k] = "p";
+		}else{
+			Map::iterator it = P.find(k);
+			if(it != P.end()) P.erase(it);
+			S.erase(k);
+		}
+	}
+	return same(P, S) && same(Q, stdQ);
+}
+
+bool check3(){ //assignment over a non-empty map, to itself and from an empty map
+	Map P, E;
+	for(int i = 0; i < 1000; i++) P[i] = "x";
+	P = Q;
+	if(!same(P, stdQ)) return 0;
+	Map &R = P;
+	P = R;
+	if(!same(P, stdQ)) return 0;
+	P = E;
+	Map C(E);
+	return P.empty() && C.empty() && P.begin() == P.end() && C.begin() == C.end();
+}
+
+bool check4(){ //a copy that throws leaves nothing behind
+	sjtu::map<int, Fragile> A, B;
+	for(int i = 0; i < 5000; i++) A[rand() % 20000] = Fragile(i);
+	for(int i = 0; i < 100; i++) B[i] = Fragile(i);
+	Fragile::left = 1234;
+	try{
+		sjtu::map<int, Fragile> C(A);
+		return 0;
+	}catch(int){}
+	Fragile::left = 77;
+	try{
+		B = A;
+		return 0;
+	}catch(int){}
+	Fragile::left = -1;
+	if(!B.empty()) return 0;
+	B = A;
+	if(B.size() != A.size()) return 0;
+	sjtu::map<int, Fragile>::iterator j = B.begin();
+	for(sjtu::map<int, Fragile>::iterator i = A.begin(); i != A.end(); i++, j++)
+		if(i -> first != j -> first || i -> second.v != j -> second.v) return 0;
+	while(A.size() > 100) A.erase(A.begin());
+	Fragile::left = 50;
+	try{
+		B = A;
+		return 0;
+	}catch(int){}
+	Fragile::left = -1;
+	return B.empty() && B.begin() == B.end();
+}
+
+bool check5(){ //copy a map which once held far more keys than it does now
+	Map A;
+	std::map<int, string> S;
+	for(int i = 0; i < 200000; i++) A[i] = to_string(i);
+	for(int i = 0; i < 200000; i++){
+		if(i % 5000 == 17){
+			S[i] = to_string(i);
+			continue;
+		}
+		A.erase(A.find(i));
+	}
+	Map B(A), C;
+	C = A;
+	if(!same(B, S) || !same(C, S) || !same(A, S)) return 0;
+	for(int i = 0; i < (int)S.size(); i++) if(B.nth(i) -> first != next(S.begin(), i) -> first || B.rank(B.nth(i) -> first) != (size_t)i) return 0;
+	for(int i = 0; i < 1000; i++){
+		B[-i] = "b"; S[-i] = "b";
+	}
+	B.erase(B.find(17));
+	S.erase(17);
+	return same(B, S) && A.size() == 40;
+}
+
+int main(){
+	srand(25);
+	if(!check1()) cout << "Test 1 Failed......" << endl; else cout << "Test 1 Passed!" << endl;
+	if(!check2()) cout << "Test 2 Failed......" << endl; else cout << "Test 2 Passed!" << endl;
+	if(!check3()) cout << "Test 3 Failed......" << endl; else cout << "Test 3 Passed!" << endl;
+	if(!check4()) cout << "Test 4 Failed......" << endl; else cout << "Test 4 Passed!" << endl;
+	if(!check5()) cout << "Test 5 Failed......" << endl; else cout << "Test 5 Passed!" << endl;
+	return 0;
+}
@@ -0,0 +1,116 @@
+#include<iostream>
+#include<map>
+#include<string>
+#include<vector>
+#include<cstdlib>
+#include<iterator>
+#include "map.hpp"
+
+using namespace std;
+
+typedef sjtu::map<int, string> Map;
+typedef sjtu::pair<const int, string> Pair;
+
+vector<Pair> src;
+std::map<int, string> stdQ;
+
+bool same(Map &Q, std::map<int, string> &stdQ){
+	if(Q.size() != stdQ.size()) return 0;
+	std::map<int, string>::iterator stdit = stdQ.begin();
+	for(Map::iterator it = Q.begin(); it != Q.end(); it++, stdit++)
+		if(it -> first != stdit -> first || it -> second != stdit -> second) return 0;
+	std::map<int, string>::reverse_iterator rit = stdQ.rbegin();
+	Map::iterator it = Q.end();
+	for(size_t i = 0; i < Q.size(); i++, rit++){
+		it--;
+		if(it -> first != rit -> first) return 0;
+	}
+	return 1;
+}
+
+bool check1(){ //build from sorted ranges of every small size
+	for(int n = 0; n <= 300; n++){
+		Map Q(src.begin(), src.begin() + n, sjtu::sorted_unique_tag());
+		std::map<int, string> S(stdQ.begin(), next(stdQ.begin(), n));
+		if(!same(Q, S)) return 0;
+		for(int i = 0; i < n; i++) if(Q.nth(i) -> first != src[i].first || Q.rank(src[i].first) != (size_t)i) return 0;
+	}
+	return 1;
+}
+
+bool check2(){ //lookups in a big build
+	Map Q(src.begin(), src.end(), sjtu::sorted_unique_tag());
+	if(!same(Q, stdQ)) return 0;
+	for(int i = 0; i < 20000; i++){
+		int k = rand() % 1000000;
+		if(Q.count(k) != stdQ.count(k)) return 0;
+		if(stdQ.count(k) && Q[k] != stdQ[k]) return 0;
+	}
+	const Map &C = Q;
+	return C.cbegin() -> first == src[0].first && (--C.cend()) -> first == src.back().first;
+}
+
+bool check3(){ //the built tree keeps working as a map
+	Map Q(src.begin(), src.end(), sjtu::sorted_unique_tag());
+	std::map<int, string> S = stdQ;
+	for(int i = 0; i < 50000; i++){
+		int k = rand() % 1000000;
+		if(rand() % 2){
+			Q[k] = to_string(i); S[k] = to_string(i);
+		}else{
+			Map::iterator it = Q.find(k);
+			if(it != Q.end()) Q.erase(it);
+			S.erase(k);
+		}
+	}
+	return same(Q, S);
+}
+
+bool check4(){ //copies and assignments of a built map
+	Map Q(src.begin(), src.end(), sjtu::sorted_unique_tag());
+	Map P(Q), R;
+	R = P;
+	Q.clear();
+	return same(P, stdQ) && same(R, stdQ) && Q.empty();
+}
+
+struct OnePass{ //a single-pass view of src, copies share the read position like istream_iterator
+	typedef input_iterator_tag iterator_category;
+	typedef Pair value_type;
+	typedef ptrdiff_t difference_type;
+	typedef const Pair *pointer;
+	typedef const Pair &reference;
+	size_t *pos, end;
+	const Pair &operator*() const { return src[*pos]; }
+	OnePass &operator++(){ ++*pos; return *this; }
+	bool done() const { return pos == NULL || *pos == end; }
+	bool operator==(const OnePass &rhs) const { return done() == rhs.done(); }
+	bool operator!=(const OnePass &rhs) const { return done() != rhs.done(); }
+};
+
+bool check5(){ //single-pass ranges are read once
+	for(size_t n = 0; n <= 5000; n += 1250){
+		size_t pos = 0;
+		OnePass b = {&pos, n}, e = {NULL, 0};
+		Map Q(b, e, sjtu::sorted_unique_tag());
+		std::map<int, string> S(stdQ.begin(), next(stdQ.begin(), n));
+		if(!same(Q, S) || pos != n) return 0;
+	}
+	return 1;
+}
+
+int main(){
+	srand(24);
+	int k = 0;
+	for(int i = 0; i < 100000; i++){
+		k += rand() % 10 + 1;
+		src.push_back(Pair(k, to_string(i)));
+		stdQ[k] = to_string(i);
+	}
+	if(!check1()) cout << "Test 1 Failed......" << endl; else cout << "Test 1 Passed!" << endl;
+	if(!check2()) cout << "Test 2 Failed......" << endl; else cout << "Test 2 Passed!" << endl;
+	if(!check3()) cout << "Test 3 Failed......" << endl; else cout << "Test 3 Passed!" << endl;
+	if(!check4()) cout << "Test 4 Failed......" << endl; else cout << "Test 4 Passed!" << endl;
+	if(!check5()) cout << "Test 5 Failed......" << endl; else cout << "Test 5 Passed!" << endl;
+	return 0;
+}
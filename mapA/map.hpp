@@ -7,15 +7,28 @@
 // only for std::less<T>
 #include <functional>
 #include <cstddef>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
 #include "utility.hpp"
 #include "exceptions.hpp"
 
 namespace sjtu {
 
+/**
+ * passed to the range constructor of map to promise that the range is sorted and has no equal keys.
+ */
+struct sorted_unique_tag {};
+
+/**
+ * the nodes are allocated Slab at a time, Slab must be a power of two.
+ */
 template<
 	class Key,
 	class T,
-	class Compare = std::less<Key>
+	class Compare = std::less<Key>,
+	size_t Slab = 64
 > class map {
 public:
 	/**
@@ -30,277 +43,546 @@ public:
 	 * if there is anything wrong throw invalid_iterator.
 	 *     like it = map.begin(); --it;
 	 *       or it = map.end(); ++end();
-	 */f
+	 */
 	
 private:
 	class RB_Tree {
 	public:
-		struct node *nil;
+		// the nodes live in slabs of Slab = 1 << S nodes and are named by 32-bit indices,
+		// node x is slot x & MASK of slab x >> S. index 0 is the sentinel nil, it is
+		// black and never holds a value. the top bit of up is the colour of a node,
+		// the other bits are the index of its parent. size counts the nodes of the
+		// subtree, it is 0 for nil.
+		// an empty tree may own no slab at all: then scap is 0 and slab is a table of one
+		// shared node holding only nil, which is read but never written. the first slab
+		// is allocated by the first create(), before anything can touch nil.
 		struct node {
-			node *ch[2], *fa, *pre, *nxt;
-			value_type v;
-			bool red;
+			unsigned ch[2], up, pre, nxt;
             int size;
-			node(const value_type &_v) : v(_v), ch{nil, nil}, fa(nil), pre(nil), nxt(nil), red(false), size(1) {}
-            node(const Key &key): v(key, T()), ch{nil, nil}, fa(nil), pre(nil), nxt(nil), red(false), size(1) {}
-            node(const node &u) v(u.v), red(u.red), size(u.size){
-                ch[0] = ch[1] = fa = pre = nxt = nil;
-            }
-			void setc(node *r, int c) {
-				ch[c] = r;
-				if (r != nil) r->fa = this;
-			}
-			int pl() {
-                if (fa != nil)
-                    return fa->ch[1] == this;
-                else
-                    return -1;
-			}
-            void count() {
-                size = ch[0]->size + ch[1]->size + 1;
-            }
-            node *brother() {
-                return fa->ch[pl() ^ 1]
-            }
+			value_type v;
 		};
-		
-		node *root, *head;
-		
+
+		static_assert(Slab >= 2 && (Slab & (Slab - 1)) == 0, "Slab must be a power of two");
+
+		static constexpr int lg(size_t x) {
+			return x < 2 ? 0 : 1 + lg(x / 2);
+		}
+
+		static const int S = lg(Slab);
+		static const unsigned MASK = (1u << S) - 1, RED = 1u << 31;
+
+		node **slab;
+		int slabs, scap;
+		unsigned root, top, fr;    // top is the first index never handed out, fr the free list linked by nxt
+
 		int size;
 
-        node *get_head() {
-            node *r = root;
-            if (r == nil) return nil;
-            while (r->ch[0] != nil) r = r->ch[0];
-            return r;
+        node &at(unsigned x) const {
+            return slab[x >> S][x & MASK];
         }
 
-        node *get_pre(node *r) {
-            if (r->ch[0] != nil) {
-                node *t = r->ch[0];
-                while (t->ch[1] != nil) t = t->ch[1];
-                return t;
-            } else {
-                while (r != nil && r->pl() != 1) r = r->fa;
-                return r;
+        unsigned fa(unsigned x) const {
+            return at(x).up & ~RED;
+        }
+
+        bool red(unsigned x) const {
+            return at(x).up & RED;
+        }
+
+        void paint(unsigned x, bool r) {
+            at(x).up = fa(x) | (r ? RED : 0);
+        }
+
+        void set_fa(unsigned x, unsigned f) {
+            at(x).up = (at(x).up & RED) | f;
+        }
+
+        void setc(unsigned f, unsigned x, int c) {
+            at(f).ch[c] = x;
+            set_fa(x, f);
+        }
+
+        int pl(unsigned x) const {
+            return at(fa(x)).ch[1] == x;
+        }
+
+        unsigned brother(unsigned x) const {
+            return at(fa(x)).ch[pl(x) ^ 1];
+        }
+
+        static node **nil_slab() {
+            alignas(node) static unsigned char nil[sizeof(node)];    // zeroed, so it is a black nil of size 0
+            static node *t[1] = {reinterpret_cast<node *>(nil)};
+            return t;
+        }
+
+        void grow() {
+            node *n = (node *) operator new(sizeof(node) << S);
+            if (slabs == scap) {
+                int ncap = scap ? scap * 2 : 4;
+                node **t;
+                try {
+                    t = new node *[ncap];
+                } catch (...) {
+                    operator delete(n);
+                    throw;
+                }
+                for (int i = 0; i < slabs; ++i) t[i] = slab[i];
+                if (scap) delete [] slab;
+                slab = t;
+                scap = ncap;
+            }
+            slab[slabs++] = n;
+            if (slabs == 1) {
+                node &nil = at(0);
+                nil.ch[0] = nil.ch[1] = nil.up = nil.pre = nil.nxt = 0;
+                nil.size = 0;
             }
         }
 
-        node *get_nxt(node *r) {
-            if (r->ch[1] != nil) {
-                node *t = r->ch[1];
-                while (t->ch[0] != nil) t = t->ch[0];
-                return t;
+        // takes a free index and builds a red node holding value_type(args...) there.
+        // a free index has size 0, so the slabs can be swept without the free list.
+        template<class... Args>
+        unsigned create(Args&&... args) {
+            unsigned x = fr;
+            if (x) {
+                fr = at(x).nxt;
             } else {
-                while (r != nil && r->pl() != 0) r = r->fa;
-                return r;
+                if ((top >> S) == (unsigned) slabs) grow();
+                x = top++;
+            }
+            node &t = at(x);
+            try {
+                new (&t.v) value_type(std::forward<Args>(args)...);
+            } catch (...) {
+                t.size = 0;
+                t.nxt = fr;
+                fr = x;
+                throw;
             }
+            t.ch[0] = t.ch[1] = t.pre = t.nxt = 0;
+            t.up = RED;
+            t.size = 1;
+            return x;
         }
 
-        void release(node *r) {
-            if (r == nil) return;
-            release(r->ch[0]);
-            release(r->ch[1]);
-            delete r;
+        void destroy(unsigned x) {
+            at(x).v.~value_type();
+            at(x).size = 0;
+            at(x).nxt = fr;
+            fr = x;
         }
-		
-		RB_Tree() {
-            nil = (node *) operator new(sizeof(node));
-            nil->pre = nil->nxt = nil->ch[0] = nil->ch[1] = nil->fa = nil;
-            nil->red = false;
-            nil->size = 0;
-            head = root = nil;
+
+        // the thread is a ring through nil: nil.nxt is the first node and nil.pre the last.
+        unsigned get_head() const {
+            return at(0).nxt;
+        }
+
+        unsigned get_tail() const {
+            return at(0).pre;
+        }
+
+        // empties the tree: the values are destroyed along the thread (not at all when that
+        // is a no-op) and every slab but the first, which holds nil, is freed whole.
+        void reset() {
+            if (slabs == 0) return;
+            if (!std::is_trivially_destructible<value_type>::value)
+                for (unsigned x = get_head(); x; x = at(x).nxt) at(x).v.~value_type();
+            for (int i = 1; i < slabs; ++i) operator delete(slab[i]);
+            slabs = 1;
+            root = fr = 0;
+            top = 1;
             size = 0;
+            at(0).pre = at(0).nxt = 0;
         }
 
+		RB_Tree() : slab(nil_slab()), slabs(0), scap(0), root(0), top(1), fr(0), size(0) {}
+
         ~RB_Tree() {
-            release(root);
-            delete nil;
+            if (scap == 0) return;
+            reset();
+            operator delete(slab[0]);
+            delete [] slab;
         }
 
-        node *newtree(node *r) {
-            if (r->size == 0) return nil;
-            node *t = new node(*r);
-            t->setc(newtree(r->ch[0]), 0);
-            t->setc(newtree(r->ch[1]), 1);
-            return t;
+        void swap(RB_Tree &other) {
+            std::swap(slab, other.slab);
+            std::swap(slabs, other.slabs);
+            std::swap(scap, other.scap);
+            std::swap(root, other.root);
+            std::swap(top, other.top);
+            std::swap(fr, other.fr);
+            std::swap(size, other.size);
+        }
+
+        // walks the values of a tree along its thread, as the source of build().
+        struct walker {
+            const RB_Tree *t;
+            unsigned x;
+
+            const value_type &operator*() const {
+                return t->at(x).v;
+            }
+
+            void operator++() {
+                x = t->at(x).nxt;
+            }
+        };
+
+        // makes this empty tree a copy of o in O(o.size). while at least half the slots o has
+        // handed out are live, it is one sweep over the slabs: every index keeps its meaning,
+        // so the links, colours, sizes and the thread are copied as they are and only the live
+        // nodes (size != 0) get their values copied. a sparser o is rebuilt from its thread
+        // instead, packed in key order without its holes.
+        void copy(const RB_Tree &o) {
+            if (o.size == 0) return;
+            if (2 * (unsigned) o.size < o.top - 1) {
+                build(walker{&o, o.get_head()}, o.size);
+                return;
+            }
+            while (((o.top - 1) >> S) >= (unsigned) slabs) grow();
+            unsigned x = 1;
+            try {
+                for (; x < o.top; ++x) {
+                    const node &a = o.at(x);
+                    node &b = at(x);
+                    if (a.size) new (&b.v) value_type(a.v);
+                    b.ch[0] = a.ch[0];
+                    b.ch[1] = a.ch[1];
+                    b.up = a.up;
+                    b.pre = a.pre;
+                    b.nxt = a.nxt;
+                    b.size = a.size;
+                }
+            } catch (...) {
+                while (--x) if (at(x).size) at(x).v.~value_type();
+                reset();
+                throw;
+            }
+            at(0).pre = o.at(0).pre;
+            at(0).nxt = o.at(0).nxt;
+            root = o.root;
+            top = o.top;
+            fr = o.fr;
+            size = o.size;
+        }
+
+        // builds a balanced tree of the next n values from first under depth d and threads
+        // them after last. nodes on the deepest level h are red, the others black.
+        template<class It>
+        unsigned build(It &first, int n, int d, int h, unsigned &last) {
+            if (n == 0) return 0;
+            unsigned l = build(first, n / 2, d + 1, h, last);
+            unsigned x = create(*first);
+            ++first;
+            ++size;
+            at(x).pre = last;
+            at(last).nxt = x;
+            last = x;
+            paint(x, d == h);
+            setc(x, l, 0);
+            setc(x, build(first, n - 1 - n / 2, d + 1, h, last), 1);
+            pull(x);
+            return x;
+        }
+
+        // the tree must be empty, the n values from first sorted with unique keys.
+        // if a value fails to copy the tree is left empty.
+        template<class It>
+        void build(It first, int n) {
+            if (n == 0) return;
+            int h = 0;
+            while ((2 << h) <= n) ++h;
+            unsigned tail = 0;
+            try {
+                root = build(first, n, 0, h, tail);
+            } catch (...) {
+                reset();
+                throw;
+            }
+            at(0).pre = tail;
+            set_fa(root, 0);
+            paint(root, false);
         }
 
-        void rotate(node *r) {
-            node *f = r->fa;
-            int c = r->pl();
-            if (f == root) root = r, r->fa = nil;
-            else f->fa->setc(r, f->pl());
-            f->setc(r->ch[c ^ 1], c);
-            r->setc(f, c ^ 1);
-            f->count();
-            r->count();
+        void pull(unsigned r) {
+            at(r).size = at(at(r).ch[0]).size + at(at(r).ch[1]).size + 1;
+        }
+
+        void rotate(unsigned r) {
+            unsigned f = fa(r);
+            int c = pl(r);
+            if (f == root) root = r, set_fa(r, 0);
+            else setc(fa(f), r, pl(f));
+            setc(f, at(r).ch[c ^ 1], c);
+            setc(r, f, c ^ 1);
+            at(r).size = at(f).size;
+            pull(f);
         }
 
         //the initial color of r must be red.
-        void insert_fix(node *r) {
-            while (r->fa->red) {
-                node *uncle = r->fa->brother();
-                if (uncle->red) {
-                    uncle->red = false;
-                    r->fa->red = false;
-                    r = r->fa->fa;
-                    r->red = true;
+        void insert_fix(unsigned r) {
+            while (red(fa(r))) {
+                unsigned uncle = brother(fa(r));
+                if (red(uncle)) {
+                    paint(uncle, false);
+                    paint(fa(r), false);
+                    r = fa(fa(r));
+                    paint(r, true);
                 } else {
+                    int c = pl(fa(r));
+                    if (pl(r) != c) rotate(r);
+                    else r = fa(r);
+                    paint(r, false);
+                    paint(fa(r), true);
                     rotate(r);
-                    r->red = false;
-                    r->fa->red = true;
-                    rotate(r);
+                    break;
                 }
             }
-            root->red = false;
+            paint(root, false);
         }
 
-        void delete_fix(node *r) {
+        void delete_fix(unsigned r) {
             if (r == root) return;
-            node *f = r->fa;
-            node *b = r->brother();
-            int c = r->pl();
-            if (!b->red && !b->ch[0]->red && !b->ch[1]->red) {
-                if (f->red) {
-                    f->red = false;
-                    b->red = true;
+            unsigned f = fa(r);
+            unsigned b = brother(r);
+            int c = pl(r);
+            if (!red(b) && !red(at(b).ch[0]) && !red(at(b).ch[1])) {
+                if (red(f)) {
+                    paint(f, false);
+                    paint(b, true);
                 } else {
-                    b->red = true;
+                    paint(b, true);
                     delete_fix(f);
                 }
             } else {
-                if (b->red) {
+                if (red(b)) {
                     rotate(b);
-                    b->red = false;
-                    f->red = true;
+                    paint(b, false);
+                    paint(f, true);
                     delete_fix(r);
                 } else {
-                    if (b->ch[c ^ 1]->red) {
+                    if (red(at(b).ch[c ^ 1])) {
                         rotate(b);
-                        b->red = f->red;
-                        f->red = false;
-                        b->ch[c ^ 1]->red = false;
+                        paint(b, red(f));
+                        paint(f, false);
+                        paint(at(b).ch[c ^ 1], false);
                     } else {
-                        node *t = b->ch[c];
+                        unsigned t = at(b).ch[c];
                         rotate(t);
-                        t->red = false;
-                        t->ch[c ^ 1]->red = true;
+                        paint(t, false);
+                        paint(at(t).ch[c ^ 1], true);
                         delete_fix(r);
                     }
                 }
             }
         }
 
-        void remove(node *r) {
-            if (r->ch[0] != nil && r->ch[1] != nil) {
-                node *t = r->ch[1];
-                while (t->ch[0] != nil) t = t->ch[0];
-                r->v = t->v;
-                remove(t);
+        // swaps the places of x and y in the tree and in the thread, the values stay where they are.
+        void swap_place(unsigned x, unsigned y) {
+            node &a = at(x), &b = at(y);
+            int c1 = pl(x), c2 = pl(y);
+            std::swap(a.ch[0], b.ch[0]);
+            std::swap(a.ch[1], b.ch[1]);
+            std::swap(a.up, b.up);
+            std::swap(a.pre, b.pre);
+            std::swap(a.nxt, b.nxt);
+            std::swap(a.size, b.size);
+
+            if (fa(x) == x) set_fa(x, y);
+            if (a.ch[0] == x) a.ch[0] = y;
+            if (a.ch[1] == x) a.ch[1] = y;
+            if (a.pre == x) a.pre = y;
+            if (a.nxt == x) a.nxt = y;
+            if (fa(y) == y) set_fa(y, x);
+            if (b.ch[0] == y) b.ch[0] = x;
+            if (b.ch[1] == y) b.ch[1] = x;
+            if (b.pre == y) b.pre = x;
+            if (b.nxt == y) b.nxt = x;
+
+            at(a.pre).nxt = x;
+            at(a.nxt).pre = x;
+            at(fa(x)).ch[c2] = x;
+            set_fa(a.ch[0], x);
+            set_fa(a.ch[1], x);
+
+            at(b.pre).nxt = y;
+            at(b.nxt).pre = y;
+            at(fa(y)).ch[c1] = y;
+            set_fa(b.ch[0], y);
+            set_fa(b.ch[1], y);
+        }
+
+        void remove(unsigned r) {
+            node &n = at(r);
+            if (n.ch[0] && n.ch[1]) {
+                unsigned t = n.nxt;
+                swap_place(r, t);
+                if (root == r) root = t;
+                remove(r);
+            } else if (!n.ch[0] && !n.ch[1]) {
+                at(n.pre).nxt = n.nxt;
+                at(n.nxt).pre = n.pre;
+                if (!red(r)) delete_fix(r);
+                if (r == root) root = 0;
+                else at(fa(r)).ch[pl(r)] = 0;
+                for (unsigned x = fa(r); x; x = fa(x)) --at(x).size;
+                destroy(r);
+                --size;
             } else {
-                node *p = get_pre(r), *q = get_nxt(r);
-                if (p != nil) p->nxt = q;
-                if (q != nil) q->pre = p;
-                if (r->red) {
-                    node *child = r->ch[0];
-                    if (child == nil) child = r->ch[1];
-                    r->fa->setc(child, r->pl());
-                    delete r;
-                } else {
-                    node *child = r->ch[0];
-                    if (child == nil) child = r->ch[1];
-                    r->fa->setc(child, r->pl());
-                    delete r;
-                    if (child.red) child.red = false;
-                    else delete_fix(child);
-                }
+                at(n.pre).nxt = n.nxt;
+                at(n.nxt).pre = n.pre;
+                swap_place(r, n.ch[0] ? n.ch[0] : n.ch[1]);
+                if (root == r) root = fa(r);
+                remove(r);
             }
         }
 
-        node *find(const Key &key) const {
-            node *r = node;
+        // the node holding key, 0 if there is none.
+        unsigned find(const Key &key) const {
+            unsigned r = root;
             auto cmp = Compare();
-            while (r != nil) {
-                if (!cmp(r->v->first, key) && !cmp(key, r->v->first)) return r;
-                else if (cmp(key, r->v->first)) r = r->ch[0];
-                else r = r->ch[1];
+            while (r) {
+                const Key &k = at(r).v.first;
+                if (cmp(key, k)) r = at(r).ch[0];
+                else if (cmp(k, key)) r = at(r).ch[1];
+                else return r;
             }
-            if (r == nil) return nullptr;
+            return 0;
         }
 
-        pair<node *, bool> insert(const value_type &V) {
-            node *r = node;
+        // descend to key. returns the node holding key, or 0 and the empty
+        // slot f->ch[c] where key belongs (f is 0 for an empty tree).
+        unsigned locate(const Key &key, unsigned &f, int &c) const {
+            unsigned r = root;
             auto cmp = Compare();
-            while (r != nil) {
-                if (!cmp(r->v->first, V.first) && !cmp(V.first, r->v->first)) return ryir<node *, bool>(r, false);
-                else if (cmp(V.key, r->v->first)) {
-                    if (r->ch[0] != nil)
-                        r = r->ch[0];
-                    else {
-                        r->setc(new node(V), 0)
-                        r = r->ch[0];
-                        node *p = get_pre(r), *q = get_nxt(r);
-                        r->pre = p; r->nxt = q;
-                        if (p != nil) p->nxt = r;
-                        if (q != nil) q->pre = r;
-                        if (p == nil) head = r;
-                        insert_fix(r);
-                        return pari<node *, bool>(r, true);
-                    }
-                } else {
-                    if (r->ch[1] != nil)
-                        r = r->ch[1];
-                    else {
-                        r->setc(new node(V), 1);
-                        r = r->ch[1];
-                        node *p = get_pre(r), *q = get_nxt(r);
-                        r->pre = p; r->nxt = q;
-                        if (p != nil) p->nxt = r;
-                        if (q != nil) q->pre = r;
-                        if (p == nil) head = r;
-                        insert_fix(r);
-                        return pari<node *, bool>(r, true);
-                    }
-                }
+            f = 0; c = 0;
+            while (r) {
+                if (cmp(key, at(r).v.first)) f = r, c = 0, r = at(r).ch[0];
+                else if (cmp(at(r).v.first, key)) f = r, c = 1, r = at(r).ch[1];
+                else return r;
             }
+            return 0;
         }
 
-        node *find_insert(const Key &key) {
-            node *r = node;
+        // hang the new red node r at the slot f->ch[c], thread it between its neighbours and rebalance.
+        void attach(unsigned r, unsigned f, int c) {
+            ++size;
+            unsigned p = 0, q = 0;
+            if (f && c == 0) q = f, p = at(f).pre;
+            else if (f) p = f, q = at(f).nxt;
+            at(r).pre = p; at(r).nxt = q;
+            at(p).nxt = r;
+            at(q).pre = r;
+            if (f == 0) {
+                root = r;
+                paint(root, false);
+                return;
+            }
+            setc(f, r, c);
+            for (unsigned x = f; x; x = fa(x)) ++at(x).size;
+            insert_fix(r);
+        }
+
+        template<class V>
+        pair<unsigned, bool> insert(V &&val) {
+            unsigned f, r;
+            int c;
+            r = locate(val.first, f, c);
+            if (r) return pair<unsigned, bool>(r, false);
+            r = create(std::forward<V>(val));
+            attach(r, f, c);
+            return pair<unsigned, bool>(r, true);
+        }
+
+        // r is a detached node, it is freed if its key is already present.
+        pair<unsigned, bool> insert_node(unsigned r) {
+            unsigned f, t;
+            int c;
+            t = locate(at(r).v.first, f, c);
+            if (t) {
+                destroy(r);
+                return pair<unsigned, bool>(t, false);
+            }
+            attach(r, f, c);
+            return pair<unsigned, bool>(r, true);
+        }
+
+        // the empty slot f->ch[c] for key if it belongs right before node h (0 is the end),
+        // found from the threads alone. false when h is no such neighbour.
+        bool near(const Key &key, unsigned h, unsigned &f, int &c) const {
             auto cmp = Compare();
-            while (r != nil) {
-                if (!cmp(r->v->first, key) && !cmp(key, r->v->first)) return r;
-                else if (cmp(key, r->v->first)) {
-                    if (r->ch[0] != nil)
-                        r = r->ch[0];
-                    else {
-                        r->setc(new node(key), 0)
-                        r = r->ch[0];
-                        node *p = get_pre(r), *q = get_nxt(r);
-                        r->pre = p; r->nxt = q;
-                        if (p != nil) p->nxt = r;
-                        if (q != nil) q->pre = r;
-                        if (p == nil) head = r;
-                        insert_fix(r);
-                        return r;
-                    }
-                } else {
-                    if (r->ch[1] != nil)
-                        r = r->ch[1];
-                    else {
-                        r->setc(new node(key), 1);
-                        r = r->ch[1];
-                        node *p = get_pre(r), *q = get_nxt(r);
-                        r->pre = p; r->nxt = q;
-                        if (p != nil) p->nxt = r;
-                        if (q != nil) q->pre = r;
-                        if (p == nil) head = r;
-                        insert_fix(r);
-                        return r;
-                    }
-                }
+            unsigned p = at(h).pre;
+            if (h && !cmp(key, at(h).v.first)) return false;
+            if (p && !cmp(at(p).v.first, key)) return false;
+            if (h && !at(h).ch[0]) f = h, c = 0;
+            else f = p, c = 1;
+            return true;
+        }
+
+        // like insert, but skips the descent when val goes right before h.
+        template<class V>
+        pair<unsigned, bool> insert(unsigned h, V &&val) {
+            unsigned f;
+            int c;
+            if (!near(val.first, h, f, c)) return insert(std::forward<V>(val));
+            unsigned r = create(std::forward<V>(val));
+            attach(r, f, c);
+            return pair<unsigned, bool>(r, true);
+        }
+
+        unsigned find_insert(const Key &key) {
+            unsigned f, r;
+            int c;
+            r = locate(key, f, c);
+            if (r) return r;
+            r = create(key, T());
+            attach(r, f, c);
+            return r;
+        }
+
+        // the node with k nodes before it, 0 (the end) when k == size.
+        unsigned kth(int k) const {
+            unsigned r = root;
+            while (r) {
+                int l = at(at(r).ch[0]).size;
+                if (k < l) r = at(r).ch[0];
+                else if (k == l) return r;
+                else k -= l + 1, r = at(r).ch[1];
+            }
+            return 0;
+        }
+
+        // the number of nodes before x, size for the end.
+        int order(unsigned x) const {
+            if (x == 0) return size;
+            int k = at(at(x).ch[0]).size;
+            for (; x != root; x = fa(x))
+                if (pl(x)) k += at(at(fa(x)).ch[0]).size + 1;
+            return k;
+        }
+
+        // the first node whose key is not less than key (greater than key if upper), 0 if there is none.
+        unsigned bound(const Key &key, bool upper) const {
+            unsigned r = root, ret = 0;
+            auto cmp = Compare();
+            while (r) {
+                if (upper ? cmp(key, at(r).v.first) : !cmp(at(r).v.first, key)) ret = r, r = at(r).ch[0];
+                else r = at(r).ch[1];
+            }
+            return ret;
+        }
+
+        // the number of keys less than key.
+        int rank(const Key &key) const {
+            unsigned r = root;
+            auto cmp = Compare();
+            int k = 0;
+            while (r) {
+                if (cmp(at(r).v.first, key)) k += at(at(r).ch[0]).size + 1, r = at(r).ch[1];
+                else r = at(r).ch[0];
             }
+            return k;
         }
 	};
 	
@@ -314,109 +596,209 @@ public:
 		 *   just add whatever you want.
 		 */
 
-        RB_Tree::node *p;
-
-        friend class const_interator;
+        unsigned p;    // the node, 0 past the end
+        RB_Tree *RB;
 
+        friend class const_iterator;
+		friend class map;
 
 	public:
-		iterator() : p(nullptr) {}
-		iterator(const iterator &other) p(other.p) {}
-        iterator(node *r) : p(r) {}
+		iterator() : p(0), RB(nullptr) {}
+		iterator(const iterator &other) : p(other.p), RB(other.RB) {}
+		iterator &operator=(const iterator &other) = default;
+        iterator(unsigned r, RB_Tree *rb) : p(r), RB(rb) {}
 		/**
 		 * return a new iterator which pointer n-next elements
 		 *   even if there are not enough elements, just return the answer.
 		 * as well as operator-
+		 * both take O(log n) through the subtree sizes, throw index_out_of_bound
+		 * when the result would lie before begin() or past end().
 		 */
+		iterator operator+(const int &n) const {
+            int k = RB->order(p) + n;
+            if (k < 0 || k > RB->size) throw index_out_of_bound();
+            return iterator(RB->kth(k), RB);
+        }
+		iterator operator-(const int &n) const {
+            return *this + (-n);
+        }
+		iterator & operator+=(const int &n) {
+            return *this = *this + n;
+        }
+		iterator & operator-=(const int &n) {
+            return *this = *this + (-n);
+        }
+		// the number of elements from rhs to this one, throw invalid_iterator if they belong to different maps.
+		int operator-(const iterator &rhs) const {
+            if (RB != rhs.RB) throw invalid_iterator();
+            return RB->order(p) - RB->order(rhs.p);
+        }
 		/**
 		 * TODO iter++
 		 */
 		iterator operator++(int) {
             iterator a(*this);
-            if (p == nullptr) throw index_out_of_bound();
-            p = p->nxt;
-            if (p->size == 0) p = nullptr;
+            if (p == 0) throw index_out_of_bound();
+            p = RB->at(p).nxt;
             return a;
         }
 		/**
 		 * TODO ++iter
 		 */
 		iterator & operator++() {
-            if (p == nullptr) throw index_out_of_bound();
-            p = p->nxt;
-            if (p->size == 0) p = nullptr;
+            if (p == 0) throw index_out_of_bound();
+            p = RB->at(p).nxt;
             return *this;
         }
 		/**
 		 * TODO iter--
 		 */
 		iterator operator--(int) {
-            if (p == nullptr) throw index_out_of_bound();
             iterator a(*this);
-            p = p->pre;
-            if (p->size == 0) {
-                p = nullptr;
-                throw index_out_of_bound();
-            }
+            if (p == 0) p = RB->get_tail();
+            else p = RB->at(p).pre;
+            if (p == 0) throw index_out_of_bound();
             return a;
         }
 		/**
 		 * TODO --iter
 		 */
 		iterator & operator--() {
-            if (p == nullptr) throw index_out_of_bound();
-            p = p->pre;
-            if (p->size == 0) {
-                p = nullptr;
-                throw index_out_of_bound();
-            }
+			if (p == 0) p = RB->get_tail();
+			else p = RB->at(p).pre;
+            if (p == 0) throw index_out_of_bound();
             return *this;
         }
 		/**
 		 * a operator to check whether two iterators are same (pointing to the same memory).
 		 */
 		value_type & operator*() const {
-            return p->v;
+            return RB->at(p).v;
         }
 		bool operator==(const iterator &rhs) const {
-            return p == rhs.p;
+            return p == rhs.p && RB == rhs.RB;
         }
 		bool operator==(const const_iterator &rhs) const {
-            return p == rhs.p;
+            return p == rhs.p && RB == rhs.RB;
         }
 		/**
 		 * some other operator for iterator.
 		 */
 		bool operator!=(const iterator &rhs) const {
-            return p != rhs.p;
+            return p != rhs.p || RB != rhs.RB;
         }
 		bool operator!=(const const_iterator &rhs) const {
-            return p != rhs.p;
+            return p != rhs.p || RB != rhs.RB;
         }
 
 		/**
 		 * for the support of it->first. 
 		 * See <http://kelvinh.github.io/blog/2013/11/20/overloading-of-member-access-operator-dash-greater-than-symbol-in-cpp/> for help.
 		 */
-		value_type* operator->() const noexcept {}
+		value_type* operator->() const noexcept {
+			return &RB->at(p).v;
+		}
 	};
 	class const_iterator {
 		// it should has similar member method as iterator.
 		//  and it should be able to construct from an iterator.
 		private:
 			// data members.
-            RB_Tree::node *p;
+            unsigned p;
+			const RB_Tree *RB;
 
             friend class iterator;
+			friend class map;
 
 		public:
-			const_iterator() : p(nullptr) {}
-			const_iterator(const const_iterator &other) : p(other.p) {}
-            const_iterator(const iterator &other) : p(other.p) {}
-            const iterator(node *r) : p(r) {}
+			const_iterator() : p(0), RB(nullptr) {}
+			const_iterator(const const_iterator &other) : p(other.p), RB(other.RB) {}
+			const_iterator &operator=(const const_iterator &other) = default;
+            const_iterator(const iterator &other) : p(other.p), RB(other.RB) {}
+            const_iterator(unsigned r, const RB_Tree *rb) : p(r), RB(rb) {}
+
+			const_iterator operator+(const int &n) const {
+		        int k = RB->order(p) + n;
+		        if (k < 0 || k > RB->size) throw index_out_of_bound();
+		        return const_iterator(RB->kth(k), RB);
+		    }
+			const_iterator operator-(const int &n) const {
+		        return *this + (-n);
+		    }
+			const_iterator & operator+=(const int &n) {
+		        return *this = *this + n;
+		    }
+			const_iterator & operator-=(const int &n) {
+		        return *this = *this + (-n);
+		    }
+			int operator-(const const_iterator &rhs) const {
+		        if (RB != rhs.RB) throw invalid_iterator();
+		        return RB->order(p) - RB->order(rhs.p);
+		    }
 			// And other methods in iterator.
 			// And other methods in iterator.
 			// And other methods in iterator.
+			
+			const_iterator operator++(int) {
+		        const_iterator a(*this);
+		        if (p == 0) throw index_out_of_bound();
+		        p = RB->at(p).nxt;
+		        return a;
+		    }
+			/**
+			 * TODO ++iter
+			 */
+			const_iterator & operator++() {
+		        if (p == 0) throw index_out_of_bound();
+		        p = RB->at(p).nxt;
+		        return *this;
+		    }
+			/**
+			 * TODO iter--
+			 */
+			const_iterator operator--(int) {
+		        const_iterator a(*this);
+		        if (p == 0) p = RB->get_tail();
+		        else p = RB->at(p).pre;
+		        if (p == 0) throw index_out_of_bound();
+		        return a;
+		    }
+			/**
+			 * TODO --iter
+			 */
+			const_iterator & operator--() {
+		        if (p == 0) p = RB->get_tail();
+		        else p = RB->at(p).pre;
+		        if (p == 0) throw index_out_of_bound();
+		        return *this;
+		    }
+			
+			const value_type & operator*() const {
+		        return RB->at(p).v;
+		    }
+			bool operator==(const iterator &rhs) const {
+		        return p == rhs.p && RB == rhs.RB;
+		    }
+			bool operator==(const const_iterator &rhs) const {
+		        return p == rhs.p && RB == rhs.RB;
+		    }
+			/**
+			 * some other operator for iterator.
+			 */
+			bool operator!=(const iterator &rhs) const {
+		        return p != rhs.p || RB != rhs.RB;
+		    }
+			bool operator!=(const const_iterator &rhs) const {
+		        return p != rhs.p || RB != rhs.RB;
+		    }
+
+			/**
+			 * for the support of it->first. 
+			 * See <http://kelvinh.github.io/blog/2013/11/20/overloading-of-member-access-operator-dash-greater-than-symbol-in-cpp/> for help.
+			 */
+			const value_type* operator->() const noexcept {
+				return &RB->at(p).v;
+			}
 	};
 	/**
 	 * TODO two constructors
@@ -425,22 +807,53 @@ public:
 private:
     RB_Tree TREE;
 
+    // a forward range is counted first and built bottom-up in O(n).
+    template<class ForwardIt>
+    void build(ForwardIt first, ForwardIt last, std::forward_iterator_tag) {
+        TREE.build(first, (int) std::distance(first, last));
+    }
+
+    // a single-pass range can only be read once, its values are inserted one by one.
+    template<class InputIt>
+    void build(InputIt first, InputIt last, std::input_iterator_tag) {
+        for (; first != last; ++first) insert(*first);
+    }
+
 public:
 	map() {
+    }
+	/**
+	 * builds the map from [first, last) in O(n), the range must be sorted by Compare
+	 * and must not hold equal keys. a single-pass range is read once and inserted
+	 * value by value instead.
+	 */
+	template<class InputIterator>
+	map(InputIterator first, InputIterator last, sorted_unique_tag) {
+        build(first, last, typename std::iterator_traits<InputIterator>::iterator_category());
     }
 	map(const map &other) {
-        TREE.root = RB_Tree::newtree(other.TREE.root);
-        TREE.size = other.size();
-        TREE.head = RB_Tree::get_head(TREE.root);
+        TREE.copy(other.TREE);
+    }
+	/**
+	 * takes over the tree of other in O(1), other is left empty and owns no memory.
+	 */
+	map(map &&other) noexcept {
+        TREE.swap(other.TREE);
     }
 	/**
 	 * TODO assignment operator
 	 */
 	map & operator=(const map &other) {
-        TREE.release(TREE.root);
-        TREE.root = RB_Tree::newtree(other.TREE.root);
-        size = other.size();
-        TREE.head = RB_Tree::get_head(TREE.root);
+        if (this == &other) return *this;
+        clear();
+        TREE.copy(other.TREE);
+        return *this;
+    }
+	map & operator=(map &&other) noexcept {
+        if (this == &other) return *this;
+        clear();
+        TREE.swap(other.TREE);
+        return *this;
     }
 	/**
 	 * TODO Destructors
@@ -453,14 +866,14 @@ public:
 	 * If no such element exists, an exception of type `index_out_of_bound'
 	 */
 	T & at(const Key &key) {
-        auto *r = TREE.find(key);
-        if (r == nullptr) throw index_out_of_bound();
-        return r->v->second;
+        unsigned r = TREE.find(key);
+        if (r == 0) throw index_out_of_bound();
+        return TREE.at(r).v.second;
     }
 	const T & at(const Key &key) const {
-        auto *r = TREE.find(key);
-        if (r == nullptr) throw index_out_of_bound();
-        return r->v->second;
+        unsigned r = TREE.find(key);
+        if (r == 0) throw index_out_of_bound();
+        return TREE.at(r).v.second;
     }
 	/**
 	 * TODO
@@ -469,35 +882,32 @@ public:
 	 *   performing an insertion if such key does not already exist.
 	 */
 	T & operator[](const Key &key) {
-        auto *r = TREE.find_insert(key);
-        return r->v->second;
+        return TREE.at(TREE.find_insert(key)).v.second;
     }
 	/**
 	 * behave like at() throw index_out_of_bound if such key does not exist.
 	 */
 	const T & operator[](const Key &key) const {
-        auto *r = TREE.find(key);
-        if (r == nullptr) throw index_out_of_bound();
-        return r->v->second;
+        return at(key);
     }
 	/**
 	 * return a iterator to the beginning
 	 */
 	iterator begin() {
-        return iterator(TREE.head);
+        return iterator(TREE.get_head(), &TREE);
     }
 	const_iterator cbegin() const {
-        return const_iterator(TREE.head);
+        return const_iterator(TREE.get_head(), &TREE);
     }
 	/**
 	 * return a iterator to the end
 	 * in fact, it returns past-the-end.
 	 */
 	iterator end() {
-        return iterator(nullptr);
+        return iterator(0, &TREE);
     }
 	const_iterator cend() const {
-        return const_iterator(nullptr);
+        return const_iterator(0, &TREE);
     }
 	/**
 	 * checks whether the container is empty
@@ -516,8 +926,7 @@ public:
 	 * clears the contents
 	 */
 	void clear() {
-        TREE.release(TREE.root);
-        TREE.root = TREE.head = TREE.nil;
+        TREE.reset();
     }
 	/**
 	 * insert an element.
@@ -526,8 +935,37 @@ public:
 	 *   the second one is true if insert successfully, or false.
 	 */
 	pair<iterator, bool> insert(const value_type &value) {
-        pair<RB_Tree::node *, bool> p = TREE.insert(value);
-        return pair<iterator, bool>(iterator(p.first), p.second);
+        pair<unsigned, bool> p = TREE.insert(value);
+        return pair<iterator, bool>(iterator(p.first, &TREE), p.second);
+    }
+	pair<iterator, bool> insert(value_type &&value) {
+        pair<unsigned, bool> p = TREE.insert(std::move(value));
+        return pair<iterator, bool>(iterator(p.first, &TREE), p.second);
+    }
+	/**
+	 * insert value as close as possible to the position just before hint.
+	 * when hint is right after value's place (e.g. end() for ascending keys)
+	 * no search is done, otherwise it is an ordinary insert.
+	 * return an iterator to the element with value's key.
+	 *
+	 * throw if hint points an element out of this
+	 */
+	iterator insert(iterator hint, const value_type &value) {
+        if (hint.RB != &TREE) throw invalid_iterator();
+        return iterator(TREE.insert(hint.p, value).first, &TREE);
+    }
+	iterator insert(iterator hint, value_type &&value) {
+        if (hint.RB != &TREE) throw invalid_iterator();
+        return iterator(TREE.insert(hint.p, std::move(value)).first, &TREE);
+    }
+	/**
+	 * constructs a value_type from args in place and inserts it if its key is not present yet.
+	 * return the same as insert.
+	 */
+	template<class... Args>
+	pair<iterator, bool> emplace(Args&&... args) {
+        pair<unsigned, bool> p = TREE.insert_node(TREE.create(std::forward<Args>(args)...));
+        return pair<iterator, bool>(iterator(p.first, &TREE), p.second);
     }
 	/**
 	 * erase the element at pos.
@@ -535,6 +973,8 @@ public:
 	 * throw if pos pointed to a bad element (pos == this->end() || pos points an element out of this)
 	 */
 	void erase(iterator pos) {
+        if (pos.p == 0) throw index_out_of_bound();
+        if (pos.RB != &TREE) throw invalid_iterator();
         TREE.remove(pos.p);
     }
 	/**
@@ -545,8 +985,8 @@ public:
 	 * The default method of check the equivalence is !(a < b || b > a)
 	 */
 	size_t count(const Key &key) const {
-        if (TREE.find(key) != nullptr) return 0;
-        else return 1;
+        if (TREE.find(key) != 0) return 1;
+        else return 0;
     }
 	/**
 	 * Finds an element with key equivalent to key.
@@ -555,12 +995,66 @@ public:
 	 *   If no such element is found, past-the-end (see end()) iterator is returned.
 	 */
 	iterator find(const Key &key) {
-        RB_Tree::node *p = TREE.find(key);
-        return iterator(p);
+        return iterator(TREE.find(key), &TREE);
     }
 	const_iterator find(const Key &key) const {
-        RB_Tree::node *p = TREE.find(key);
-        return const_iterator(p);
+        return const_iterator(TREE.find(key), &TREE);
+    }
+
+	/**
+	 * returns an iterator to the element with the k-th smallest key (counted from 0),
+	 *   or end() if k >= size().
+	 */
+	iterator nth(const size_t &k) {
+        if (k >= size()) return end();
+        return iterator(TREE.kth(k), &TREE);
+    }
+	const_iterator nth(const size_t &k) const {
+        if (k >= size()) return cend();
+        return const_iterator(TREE.kth(k), &TREE);
+    }
+	/**
+	 * returns the number of keys less than key.
+	 */
+	size_t rank(const Key &key) const {
+        return TREE.rank(key);
+    }
+	/**
+	 * returns an iterator to the first element whose key is not less than key,
+	 *   or end() if there is none.
+	 */
+	iterator lower_bound(const Key &key) {
+        return iterator(TREE.bound(key, false), &TREE);
+    }
+	const_iterator lower_bound(const Key &key) const {
+        return const_iterator(TREE.bound(key, false), &TREE);
+    }
+	/**
+	 * returns an iterator to the first element whose key is greater than key,
+	 *   or end() if there is none.
+	 */
+	iterator upper_bound(const Key &key) {
+        return iterator(TREE.bound(key, true), &TREE);
+    }
+	const_iterator upper_bound(const Key &key) const {
+        return const_iterator(TREE.bound(key, true), &TREE);
+    }
+	/**
+	 * returns the range of elements whose key is equivalent to key,
+	 *   that is (lower_bound(key), upper_bound(key)).
+	 */
+	pair<iterator, iterator> equal_range(const Key &key) {
+        return pair<iterator, iterator>(lower_bound(key), upper_bound(key));
+    }
+	pair<const_iterator, const_iterator> equal_range(const Key &key) const {
+        return pair<const_iterator, const_iterator>(lower_bound(key), upper_bound(key));
+    }
+	/**
+	 * returns the number of keys in [lo, hi), 0 if hi is not greater than lo.
+	 */
+	size_t count_range(const Key &lo, const Key &hi) const {
+        int a = TREE.rank(lo), b = TREE.rank(hi);
+        return b > a ? b - a : 0;
     }
 };
 
@@ -0,0 +1,51 @@
+#include <iostream>
+#include <string>
+
+#include "priority_queue.hpp"
+
+struct Item {
+	static int copies;
+	int v;
+	std::string name;
+	Item(int v, const std::string &name = "") : v(v), name(name) {}
+	Item(const Item &o) : v(o.v), name(o.name) { ++copies; }
+	Item(Item &&o) noexcept : v(o.v), name(std::move(o.name)) { o.v = -1; }
+	bool operator<(const Item &o) const { return v < o.v; }
+};
+int Item::copies = 0;
+
+void drain(sjtu::priority_queue<Item> &q)
+{
+	while (!q.empty()) {
+		std::cout << q.top().v << q.top().name << " ";
+		q.pop();
+	}
+	std::cout << std::endl;
+}
+
+int main()
+{
+	sjtu::priority_queue<Item> a;
+	for (int i = 0; i < 10; ++i) {
+		a.push(Item(i * 3 % 10));
+	}
+	Item x(42, "x");
+	a.push(std::move(x));
+	a.emplace(7, "e");
+	a.emplace(99);
+	std::cout << a.size() << " " << x.v << " " << Item::copies << std::endl;
+
+	sjtu::priority_queue<Item> b(std::move(a));
+	std::cout << a.size() << " " << a.empty() << " " << b.size() << " " << b.top().v << std::endl;
+	sjtu::priority_queue<Item> c;
+	c.emplace(1000);
+	c = std::move(b);
+	std::cout << b.size() << " " << c.size() << " " << c.top().v << std::endl;
+	c = std::move(c);
+	std::cout << c.size() << std::endl;
+	a.emplace(5, "again");
+	drain(a);
+	drain(c);
+	std::cout << Item::copies << std::endl;
+	return 0;
+}
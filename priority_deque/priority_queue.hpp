@@ -3,6 +3,7 @@
 
 #include <cstddef>
 #include <functional>
+#include <utility>
 #include "exceptions.hpp"
 
 namespace sjtu {
@@ -21,12 +22,17 @@ void swap(T &a, T &b) {
 template<typename T, class Compare = std::less<T>>
 class priority_queue {
 private:
+    struct in_place {};
+
     class node {
     public:
         T v;
         int h;
         node *ch[2];
         node(const T &c) : v(c), ch{nullptr, nullptr}, h(0) {}
+        node(T &&c) : v(std::move(c)), h(0), ch{nullptr, nullptr} {}
+        template<class... Args>
+        explicit node(in_place, Args&&... args) : v(std::forward<Args>(args)...), h(0), ch{nullptr, nullptr} {}
         node(const node &t) : v(t.v), ch{nullptr, nullptr}, h(0) {}
     };
     
@@ -58,6 +64,13 @@ public:
 	priority_queue(const priority_queue &other) {
         sz = other.size();
         root = newtree(other.root);
+    }
+	/**
+	 * takes over the heap of other in O(1), other is left empty.
+	 */
+	priority_queue(priority_queue &&other) noexcept : root(other.root), sz(other.sz) {
+        other.root = nullptr;
+        other.sz = 0;
     }
 	/**
 	 * TODO deconstructor
@@ -74,6 +87,15 @@ public:
         clean(root);
         root = newtree(other.root);
         return *this;
+    }
+	priority_queue &operator=(priority_queue &&other) noexcept {
+        if (&other == this) return *this;
+        clean(root);
+        root = other.root;
+        sz = other.sz;
+        other.root = nullptr;
+        other.sz = 0;
+        return *this;
     }
 	/**
 	 * get the top of the queue.
@@ -94,6 +116,20 @@ public:
         root = merge(root, rt);
         ++sz;
 	}
+	void push(T &&e) {
+        node *rt = new node(std::move(e));
+        root = merge(root, rt);
+        ++sz;
+	}
+	/**
+	 * constructs the new element from args in place.
+	 */
+	template<class... Args>
+	void emplace(Args&&... args) {
+        node *rt = new node(in_place(), std::forward<Args>(args)...);
+        root = merge(root, rt);
+        ++sz;
+	}
 	/**
 	 * TODO
 	 * delete the top element.
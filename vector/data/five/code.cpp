@@ -0,0 +1,139 @@
+#include "vector.hpp"
+
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+template<class V>
+void print(const V &v)
+{
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << v[i] << " ";
+	}
+	std::cout << std::endl;
+}
+
+void TestRangeInsert()
+{
+	std::cout << "Testing range insert..." << std::endl;
+	sjtu::vector<int> v;
+	v.reserve(20);
+	for (int i = 0; i < 10; ++i) {
+		v.push_back(i);
+	}
+	std::vector<int> src;
+	for (int i = 100; i < 130; ++i) {
+		src.push_back(i);
+	}
+	v.insert(v.begin() + 2, src.begin(), src.begin() + 3);
+	print(v);
+	v.insert(v.begin() + 11, src.begin() + 3, src.begin() + 8);
+	print(v);
+	v.insert(v.end(), src.begin() + 8, src.begin() + 10);
+	print(v);
+	sjtu::vector<int>::iterator it = v.insert(v.begin() + 1, src.begin() + 10, src.end());
+	std::cout << *it << " " << v.size() << std::endl;
+	print(v);
+	sjtu::vector<int>::iterator jt = v.insert(v.begin() + 4, src.begin(), src.begin());
+	std::cout << *jt << " " << v.size() << std::endl;
+	sjtu::vector<int> w;
+	w.insert(w.begin(), v.begin(), v.begin() + 5);
+	w.insert(w.begin() + 2, v.cbegin() + 5, v.cbegin() + 8);
+	print(w);
+	try {
+		w.insert(v.begin(), src.begin(), src.end());
+	} catch (sjtu::invalid_iterator &) {
+		std::cout << "invalid_iterator thrown correctly." << std::endl;
+	}
+	sjtu::vector<int>::iterator kt = w.insert(w.begin() + 1, 3, 7);
+	std::cout << *kt << " " << w.size() << std::endl;
+	w.insert(w.end(), 0, 9);
+	w.insert(w.begin(), 20, w[2]);
+	print(w);
+}
+
+void TestRangeErase()
+{
+	std::cout << "Testing range erase..." << std::endl;
+	sjtu::vector<std::string> v;
+	for (int i = 0; i < 12; ++i) {
+		v.push_back(std::string(i % 3 + 1, 'a' + i));
+	}
+	v.erase(v.begin() + 2, v.begin() + 5);
+	print(v);
+	v.erase(v.begin() + 6, v.end());
+	print(v);
+	sjtu::vector<std::string>::iterator it = v.erase(v.begin(), v.begin() + 2);
+	std::cout << *it << std::endl;
+	v.erase(v.begin() + 1, v.begin() + 1);
+	print(v);
+	try {
+		v.erase(v.begin() + 3, v.begin() + 1);
+	} catch (sjtu::invalid_iterator &) {
+		std::cout << "invalid_iterator thrown correctly." << std::endl;
+	}
+}
+
+void TestAssign()
+{
+	std::cout << "Testing assign..." << std::endl;
+	sjtu::vector<std::string> v;
+	std::vector<std::string> src;
+	for (int i = 0; i < 8; ++i) {
+		src.push_back(std::to_string(i * i));
+	}
+	v.assign(src.begin(), src.end());
+	print(v);
+	v.assign(src.begin() + 5, src.begin() + 7);
+	print(v);
+	v.assign(3, "x");
+	print(v);
+}
+
+void TestResize()
+{
+	std::cout << "Testing resize, reserve and shrink_to_fit..." << std::endl;
+	sjtu::vector<long long> v;
+	v.reserve(100);
+	std::cout << v.size() << " " << v.capacity() << std::endl;
+	v.resize(5);
+	print(v);
+	v.resize(8, 7);
+	print(v);
+	v.resize(3);
+	print(v);
+	v.shrink_to_fit();
+	std::cout << v.size() << " " << v.capacity() << std::endl;
+}
+
+void TestInputIterators()
+{
+	std::cout << "Testing single-pass ranges..." << std::endl;
+	std::istringstream in("1 2 3 4 5 6 7");
+	sjtu::vector<long long> v;
+	v.insert(v.begin(), std::istream_iterator<long long>(in), std::istream_iterator<long long>());
+	print(v);
+	std::istringstream mid("10 20 30");
+	v.insert(v.begin() + 2, std::istream_iterator<long long>(mid), std::istream_iterator<long long>());
+	print(v);
+	std::istringstream words("one two three");
+	sjtu::vector<std::string> w;
+	w.push_back("zero");
+	w.insert(w.begin(), std::istream_iterator<std::string>(words), std::istream_iterator<std::string>());
+	print(w);
+	std::istringstream again("8 9");
+	v.assign(std::istream_iterator<long long>(again), std::istream_iterator<long long>());
+	print(v);
+}
+
+int main()
+{
+	TestRangeInsert();
+	TestRangeErase();
+	TestAssign();
+	TestResize();
+	TestInputIterators();
+	return 0;
+}
@@ -0,0 +1,167 @@
+#include "small_vector.hpp"
+
+#include "class-integer.hpp"
+#include "class-matrix.hpp"
+#include "class-bint.hpp"
+
+#include <iostream>
+
+void TestInline()
+{
+	std::cout << "Testing inline storage..." << std::endl;
+	sjtu::small_vector<int, 16> v;
+	std::cout << v.size() << " " << v.capacity() << std::endl;
+	for (int i = 0; i < 16; ++i) {
+		v.push_back(i);
+	}
+	std::cout << v.size() << " " << v.capacity() << std::endl;
+	v.insert(v.begin() + 3, 100);
+	std::cout << v.size() << " " << (v.capacity() > 16) << std::endl;
+	for (sjtu::small_vector<int, 16>::iterator it = v.begin(); it != v.end(); ++it) {
+		std::cout << *it << " ";
+	}
+	std::cout << std::endl;
+	v.erase(v.begin() + 3);
+	v.erase(0);
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << v[i] << " ";
+	}
+	std::cout << std::endl;
+}
+
+void TestBound()
+{
+	std::cout << "Testing exceptions..." << std::endl;
+	sjtu::small_vector<long long, 4> v;
+	try {
+		v.front();
+	} catch (sjtu::container_is_empty) {
+		std::cout << "container_is_empty thrown correctly." << std::endl;
+	}
+	try {
+		v.pop_back();
+	} catch (sjtu::container_is_empty) {
+		std::cout << "container_is_empty thrown correctly." << std::endl;
+	}
+	for (long long i = 0; i < 3; ++i) {
+		v.push_back(1LL << (i * 20));
+	}
+	std::cout << v.at(2) << " " << v.back() << std::endl;
+	try {
+		std::cout << v.at(3) << std::endl;
+	} catch (sjtu::index_out_of_bound) {
+		std::cout << "index_out_of_bound thrown correctly." << std::endl;
+	}
+	try {
+		std::cout << v[10] << std::endl;
+	} catch (sjtu::index_out_of_bound) {
+		std::cout << "index_out_of_bound thrown correctly." << std::endl;
+	}
+	try {
+		v.insert(5, 0);
+	} catch (sjtu::index_out_of_bound) {
+		std::cout << "index_out_of_bound thrown correctly." << std::endl;
+	}
+	sjtu::small_vector<long long, 4> w;
+	try {
+		std::cout << v.begin() - w.begin() << std::endl;
+	} catch (sjtu::invalid_iterator) {
+		std::cout << "invalid_iterator thrown correctly." << std::endl;
+	}
+}
+
+void TestCopy()
+{
+	std::cout << "Testing copy between vector and small_vector..." << std::endl;
+	sjtu::small_vector<int, 8> a;
+	for (int i = 0; i < 5; ++i) {
+		a.push_back(i * i);
+	}
+	sjtu::small_vector<int, 8> b(a);
+	b.push_back(-1);
+	sjtu::vector<int> c(a);
+	for (int i = 0; i < 10; ++i) {
+		c.push_back(i);
+	}
+	a = c;
+	std::cout << a.size() << " " << b.size() << " " << c.size() << std::endl;
+	for (size_t i = 0; i < a.size(); ++i) {
+		std::cout << a[i] << " ";
+	}
+	std::cout << std::endl;
+	b = b;
+	a = b;
+	for (sjtu::small_vector<int, 8>::const_iterator it = a.cbegin(); it != a.cend(); ++it) {
+		std::cout << *it << " ";
+	}
+	std::cout << std::endl;
+	sjtu::vector<int> &r = a;
+	r.push_back(7);
+	std::cout << a.back() << " " << a.size() << std::endl;
+}
+
+void TestClass()
+{
+	std::cout << "Testing classes..." << std::endl;
+	sjtu::small_vector<Integer, 2> vInt;
+	for (int i = 1; i <= 100; ++i) {
+		vInt.push_back(Integer(i));
+	}
+	std::cout << vInt.size() << std::endl;
+	sjtu::small_vector<Diamond::Matrix<double>, 3> vM;
+	for (int i = 1; i <= 5; ++i) {
+		vM.push_back(Diamond::Matrix<double>(i, i, i));
+	}
+	vM.insert(vM.begin(), Diamond::Matrix<double>(1, 2, 0.5));
+	for (size_t i = 0; i < vM.size(); ++i) {
+		std::cout << vM[i] << std::endl;
+	}
+	sjtu::small_vector<Util::Bint, 4> vBint;
+	for (long long i = 1LL << 50; i < (1LL << 50) + 6; ++i) {
+		vBint.insert(vBint.begin(), Util::Bint(i) * i);
+	}
+	sjtu::small_vector<Util::Bint, 4> cBint(vBint);
+	vBint.clear();
+	for (sjtu::small_vector<Util::Bint, 4>::iterator it = cBint.begin(); it != cBint.end(); ++it) {
+		std::cout << *it << " ";
+	}
+	std::cout << std::endl;
+}
+
+void TestInlineAgain()
+{
+	std::cout << "Testing the inline buffer after move and shrink_to_fit..." << std::endl;
+	sjtu::small_vector<int, 4> a;
+	for (int i = 0; i < 10; ++i) {
+		a.push_back(i);
+	}
+	sjtu::small_vector<int, 4> b(std::move(a));
+	std::cout << a.size() << " " << a.capacity() << " " << b.size() << std::endl;
+	for (int i = 0; i < 3; ++i) {
+		a.push_back(i * 10);
+	}
+	std::cout << a.size() << " " << a.capacity() << std::endl;
+	b.erase(b.begin() + 3, b.end());
+	b.shrink_to_fit();
+	std::cout << b.size() << " " << b.capacity() << std::endl;
+	b.push_back(-1);
+	for (size_t i = 0; i < b.size(); ++i) {
+		std::cout << b[i] << " ";
+	}
+	std::cout << std::endl;
+	sjtu::vector<int> c;
+	c.push_back(5);
+	c.pop_back();
+	c.shrink_to_fit();
+	std::cout << c.size() << " " << c.capacity() << std::endl;
+}
+
+int main()
+{
+	TestInline();
+	TestBound();
+	TestCopy();
+	TestClass();
+	TestInlineAgain();
+	return 0;
+}
@@ -0,0 +1,150 @@
+#include "small_vector.hpp"
+
+#include <iostream>
+#include <string>
+
+struct Item {
+	static int copies;
+	int v;
+	Item(int v) : v(v) {}
+	Item(const Item &o) : v(o.v) { ++copies; }
+	Item(Item &&o) noexcept : v(o.v) { o.v = -1; }
+	Item &operator=(const Item &o) { v = o.v; ++copies; return *this; }
+	Item &operator=(Item &&o) noexcept { v = o.v; o.v = -1; return *this; }
+};
+int Item::copies = 0;
+
+// has no move constructor, so it is copied, and the copy throws once budget runs out
+struct Fragile {
+	static int budget;
+	int v;
+	Fragile(int v) : v(v) {}
+	Fragile(const Fragile &o) : v(o.v) {
+		if (budget == 0) throw -1;
+		if (budget > 0) --budget;
+	}
+	Fragile &operator=(const Fragile &o) { v = o.v; return *this; }
+};
+int Fragile::budget = -1;
+
+template<class V>
+void print(const V &v)
+{
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << v[i].v << " ";
+	}
+	std::cout << std::endl;
+}
+
+void TestPush()
+{
+	std::cout << "Testing push_back(T &&) and emplace..." << std::endl;
+	sjtu::vector<Item> a;
+	for (int i = 0; i < 10; ++i) {
+		a.push_back(Item(i));
+	}
+	Item x(100);
+	a.push_back(std::move(x));
+	a.insert(a.begin() + 2, Item(200));
+	Item y(300);
+	a.insert(5, std::move(y));
+	a.emplace_back(400);
+	a.emplace(a.begin(), 500);
+	a.emplace(3, 600);
+	print(a);
+	std::cout << x.v << " " << y.v << " " << Item::copies << std::endl;
+}
+
+void TestMove()
+{
+	std::cout << "Testing move constructor and move assignment..." << std::endl;
+	Item::copies = 0;
+	sjtu::vector<Item> a;
+	for (int i = 0; i < 20; ++i) {
+		a.emplace_back(i);
+	}
+	sjtu::vector<Item> b(std::move(a));
+	std::cout << a.size() << " " << b.size() << std::endl;
+	sjtu::vector<Item> c;
+	c.emplace_back(-5);
+	c = std::move(b);
+	std::cout << b.size() << " " << c.size() << " " << c.front().v << " " << c.back().v << std::endl;
+	c = std::move(c);
+	std::cout << c.size() << std::endl;
+	sjtu::small_vector<Item, 4> s;
+	for (int i = 0; i < 3; ++i) {
+		s.emplace_back(i * 7);
+	}
+	sjtu::small_vector<Item, 4> t(std::move(s));
+	print(t);
+	sjtu::vector<Item> d(std::move(t));
+	d.push_back(Item(1));
+	print(d);
+	std::cout << s.size() << " " << t.size() << " " << Item::copies << std::endl;
+}
+
+void TestString()
+{
+	std::cout << "Testing strings..." << std::endl;
+	sjtu::vector<std::string> v;
+	std::string s(50, 'x');
+	v.push_back(std::move(s));
+	v.emplace_back(3, 'y');
+	v.emplace(v.begin(), "front");
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << v[i] << std::endl;
+	}
+}
+
+void TestNested()
+{
+	std::cout << "Testing vectors of vectors..." << std::endl;
+	Item::copies = 0;
+	sjtu::vector<sjtu::vector<Item> > v;
+	for (int i = 0; i < 1100; ++i) {
+		sjtu::vector<Item> inner;
+		for (int j = 0; j <= i % 10; ++j) {
+			inner.emplace_back(i + j);
+		}
+		v.push_back(std::move(inner));
+	}
+	sjtu::small_vector<Item, 4> s;
+	s.emplace_back(7);
+	v.push_back(std::move(s));
+	v.insert(v.begin() + 3, sjtu::vector<Item>());
+	std::cout << v.size() << " " << v[1099].size() << " " << v[1099].back().v << " " << v[1101][0].v << std::endl;
+	std::cout << Item::copies << std::endl;
+}
+
+void TestBaseMove()
+{
+	std::cout << "Testing a small_vector moved through vector &&..." << std::endl;
+	sjtu::small_vector<Fragile, 4> s;
+	for (int i = 0; i < 3; ++i) {
+		s.emplace_back(i + 1);
+	}
+	sjtu::vector<Fragile> &r = s;
+	Fragile::budget = 1;
+	try {
+		sjtu::small_vector<Fragile, 2> t(std::move(r));
+		std::cout << "no throw" << std::endl;
+	} catch (int) {
+		std::cout << "caught" << std::endl;
+	}
+	Fragile::budget = -1;
+	print(s);
+	sjtu::small_vector<Fragile, 2> u;
+	u = std::move(r);
+	print(u);
+	std::cout << s.size() << std::endl;
+}
+
+int main()
+{
+	TestPush();
+	TestMove();
+	TestString();
+	TestNested();
+	TestBaseMove();
+	return 0;
+}
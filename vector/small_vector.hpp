@@ -0,0 +1,77 @@
+#ifndef SJTU_SMALL_VECTOR_HPP
+#define SJTU_SMALL_VECTOR_HPP
+
+#include "vector.hpp"
+
+#include <cstddef>
+#include <utility>
+
+namespace sjtu {
+/**
+ * a vector which keeps up to N elements inside the object itself and only
+ * moves them to the heap once it grows past N.
+ *
+ * it is a sjtu::vector<T> in every other way: the same iterators, the same
+ * bounds checking in at() / operator[], the same exceptions, and it can be
+ * passed wherever a vector<T> & is expected.
+ * the one exception is moving from it through a vector<T> && into a plain vector:
+ * vector's move constructor and move assignment are noexcept and only hand over
+ * heap buffers, so move it as a small_vector, or into a small_vector, instead.
+ */
+template<typename T, size_t N>
+class small_vector : public vector<T> {
+    static_assert(N > 0, "small_vector needs room for at least one element");
+private:
+    alignas(T) unsigned char buf[N * sizeof(T)];
+
+public:
+	small_vector() : vector<T>(reinterpret_cast<T *>(buf), N) {}
+	small_vector(const small_vector &other) : vector<T>(reinterpret_cast<T *>(buf), N) {
+        vector<T>::operator=(other);
+    }
+	small_vector(const vector<T> &other) : vector<T>(reinterpret_cast<T *>(buf), N) {
+        vector<T>::operator=(other);
+    }
+	small_vector(small_vector &&other) : vector<T>(reinterpret_cast<T *>(buf), N) {
+        this->move_from(other);
+    }
+	small_vector(vector<T> &&other) : vector<T>(reinterpret_cast<T *>(buf), N) {
+        this->move_from(other);
+    }
+	small_vector &operator=(const small_vector &other) {
+        vector<T>::operator=(other);
+        return *this;
+    }
+	small_vector &operator=(const vector<T> &other) {
+        vector<T>::operator=(other);
+        return *this;
+    }
+	small_vector &operator=(small_vector &&other) {
+        this->move_from(other);
+        return *this;
+    }
+	small_vector &operator=(vector<T> &&other) {
+        this->move_from(other);
+        return *this;
+    }
+};
+
+// a small_vector may still keep its elements inline, so moving it into a plain
+// vector can allocate and move them one by one. this path is kept apart from
+// vector(vector &&), which only swaps pointers and stays noexcept.
+template<typename T, size_t GrowNum, size_t GrowDen>
+template<size_t N>
+vector<T, GrowNum, GrowDen>::vector(small_vector<T, N> &&other) : vector() {
+    move_from(other);
+}
+
+template<typename T, size_t GrowNum, size_t GrowDen>
+template<size_t N>
+vector<T, GrowNum, GrowDen> &vector<T, GrowNum, GrowDen>::operator=(small_vector<T, N> &&other) {
+    move_from(other);
+    return *this;
+}
+
+}
+
+#endif
@@ -5,13 +5,29 @@
 
 #include <climits>
 #include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 namespace sjtu {
+
+template<typename T, size_t N>
+class small_vector;
+
 /**
  * a data container like std::vector
  * store data in a successive memory and support random access.
+ *
+ * the storage is a raw buffer of capacity() slots, only the first size() of
+ * them hold constructed elements. when it runs out the buffer grows by
+ * GrowNum / GrowDen (at least by one slot), so a sequence of push_back costs
+ * amortized O(1) and O(log n) reallocations in total. elements are moved
+ * (copied only if their move constructor may throw) into the new buffer.
  */
-template<typename T>
+template<typename T, size_t GrowNum = 2, size_t GrowDen = 1>
 class vector {
 public:
 	/**
@@ -24,169 +40,958 @@ public:
 	 */
 	class const_iterator;
 	class iterator {
+        friend class vector;
+        friend class const_iterator;
+	public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef int difference_type;
+        typedef T *pointer;
+        typedef T &reference;
 	private:
 		/**
 		 * TODO add data members
 		 *   just add whatever you want.
 		 */
+        T *p;
+        vector *v;
 	public:
+        iterator() : p(nullptr), v(nullptr) {}
+        iterator(const iterator &other) : p(other.p), v(other.v) {}
+        iterator(T *_p, vector *_v) : p(_p), v(_v) {}
 		/**
 		 * return a new iterator which pointer n-next elements
 		 *   even if there are not enough elements, just return the answer.
 		 * as well as operator-
 		 */
 		iterator operator+(const int &n) const {
-			//TODO
+            return iterator(p + n, v);
 		}
 		iterator operator-(const int &n) const {
-			//TODO
+            return iterator(p - n, v);
 		}
 		// return th distance between two iterator,
 		// if these two iterators points to different vectors, throw invaild_iterator.
 		int operator-(const iterator &rhs) const {
-			//TODO
+            if (v != rhs.v) throw invalid_iterator();
+            return p - rhs.p;
 		}
 		iterator operator+=(const int &n) {
-			//TODO
+            p += n;
+            return *this;
 		}
 		iterator operator-=(const int &n) {
-			//TODO
+            p -= n;
+            return *this;
 		}
 		/**
 		 * TODO iter++
 		 */
-		iterator operator++(int) {}
+		iterator operator++(int) {
+            iterator a = (*this);
+            ++p;
+            return a;
+        }
 		/**
 		 * TODO ++iter
 		 */
-		iterator& operator++() {}
+		iterator& operator++() {
+            ++p;
+            return *this;
+        }
 		/**
 		 * TODO iter--
 		 */
-		iterator operator--(int) {}
+		iterator operator--(int) {
+            iterator a = (*this);
+            --p;
+            return a;
+        }
 		/**
 		 * TODO --iter
 		 */
-		iterator& operator--() {}
+		iterator& operator--() {
+            --p;
+            return *this;
+        }
 		/**
 		 * TODO *it
 		 */
-		T& operator*() const{}
+		T& operator*() const {
+            return *p;
+        }
+        T* operator->() const noexcept {
+            return p;
+        }
 		/**
 		 * a operator to check whether two iterators are same (pointing to the same memory).
 		 */
-		bool operator==(const iterator &rhs) const {}
-		bool operator==(const const_iterator &rhs) const {}
+		bool operator==(const iterator &rhs) const {
+            return p == rhs.p;
+        }
+		bool operator==(const const_iterator &rhs) const {
+            return p == rhs.p;
+        }
 		/**
 		 * some other operator for iterator.
 		 */
-		bool operator!=(const iterator &rhs) const {}
-		bool operator!=(const const_iterator &rhs) const {}
+		bool operator!=(const iterator &rhs) const {
+            return p != rhs.p;
+        }
+		bool operator!=(const const_iterator &rhs) const {
+            return p != rhs.p;
+        }
 	};
 	/**
 	 * TODO
 	 * has same function as iterator, just for a const object.
 	 */
 	class const_iterator {
+        friend class vector;
+        friend class iterator;
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef int difference_type;
+        typedef const T *pointer;
+        typedef const T &reference;
+    private:
+        const T *p;
+        const vector *v;
+    public:
+        const_iterator() : p(nullptr), v(nullptr) {}
+        const_iterator(const const_iterator &other) : p(other.p), v(other.v) {}
+        const_iterator(const iterator &other) : p(other.p), v(other.v) {}
+        const_iterator(const T *_p, const vector *_v) : p(_p), v(_v) {}
 
+        const_iterator operator+(const int &n) const {
+            return const_iterator(p + n, v);
+        }
+        const_iterator operator-(const int &n) const {
+            return const_iterator(p - n, v);
+        }
+        int operator-(const const_iterator &rhs) const {
+            if (v != rhs.v) throw invalid_iterator();
+            return p - rhs.p;
+        }
+        const_iterator operator+=(const int &n) {
+            p += n;
+            return *this;
+        }
+        const_iterator operator-=(const int &n) {
+            p -= n;
+            return *this;
+        }
+        const_iterator operator++(int) {
+            const_iterator a = (*this);
+            ++p;
+            return a;
+        }
+        const_iterator& operator++() {
+            ++p;
+            return *this;
+        }
+        const_iterator operator--(int) {
+            const_iterator a = (*this);
+            --p;
+            return a;
+        }
+        const_iterator& operator--() {
+            --p;
+            return *this;
+        }
+        const T& operator*() const {
+            return *p;
+        }
+        const T* operator->() const noexcept {
+            return p;
+        }
+        bool operator==(const iterator &rhs) const {
+            return p == rhs.p;
+        }
+        bool operator==(const const_iterator &rhs) const {
+            return p == rhs.p;
+        }
+        bool operator!=(const iterator &rhs) const {
+            return p != rhs.p;
+        }
+        bool operator!=(const const_iterator &rhs) const {
+            return p != rhs.p;
+        }
 	};
+
+private:
+    T *first, *last, *bound;
+    // the inline buffer of a small_vector and its capacity, nullptr and 0 for a plain vector.
+    // it is never freed.
+    T *local;
+    size_t local_cap;
+
+    /**
+     * trivially copyable types can be moved around as raw bytes: their buffer
+     * comes from malloc so growth can try realloc in place, and shifting the
+     * tail on insert / erase is a single memmove instead of a loop of
+     * assignments. other types go through operator new and element-wise moves.
+     */
+    typedef std::integral_constant<bool, std::is_trivially_copyable<T>::value> trivial;
+
+    static T *allocate(size_t n) {
+        if (n == 0) return nullptr;
+        return allocate(n, trivial());
+    }
+
+    static T *allocate(size_t n, std::true_type) {
+        void *p = std::malloc(n * sizeof(T));
+        if (p == nullptr) throw std::bad_alloc();
+        return static_cast<T *>(p);
+    }
+
+    static T *allocate(size_t n, std::false_type) {
+        return static_cast<T *>(operator new(n * sizeof(T)));
+    }
+
+    static void deallocate(T *p) {
+        deallocate(p, trivial());
+    }
+
+    static void deallocate(T *p, std::true_type) {
+        std::free(p);
+    }
+
+    static void deallocate(T *p, std::false_type) {
+        operator delete(p);
+    }
+
+    void release(T *p) {
+        if (p != local) deallocate(p);
+    }
+
+    static void destroy(T *b, T *e) {
+        for (; b != e; ++b) b->~T();
+    }
+
+    // move [b, e) into the raw memory at d, roll back if a constructor throws.
+    static T *relocate(T *b, T *e, T *d) {
+        return relocate(b, e, d, trivial());
+    }
+
+    static T *relocate(T *b, T *e, T *d, std::true_type) {
+        if (b != e) std::memcpy(d, b, (e - b) * sizeof(T));
+        return d + (e - b);
+    }
+
+    static T *relocate(T *b, T *e, T *d, std::false_type) {
+        T *t = d;
+        try {
+            for (; b != e; ++b, ++t)
+                new (t) T(std::move_if_noexcept(*b));
+        } catch (...) {
+            destroy(d, t);
+            throw;
+        }
+        return t;
+    }
+
+    static T *copy_construct(const T *b, const T *e, T *d) {
+        return copy_construct(b, e, d, trivial());
+    }
+
+    static T *copy_construct(const T *b, const T *e, T *d, std::true_type) {
+        if (b != e) std::memcpy(d, b, (e - b) * sizeof(T));
+        return d + (e - b);
+    }
+
+    static T *copy_construct(const T *b, const T *e, T *d, std::false_type) {
+        T *t = d;
+        try {
+            for (; b != e; ++b, ++t)
+                new (t) T(*b);
+        } catch (...) {
+            destroy(d, t);
+            throw;
+        }
+        return t;
+    }
+
+    // the capacity after one more growth step, never less than need.
+    size_t next_capacity(size_t need) const {
+        size_t c = capacity() * GrowNum / GrowDen;
+        if (c <= capacity()) c = capacity() + 1;
+        return c < need ? need : c;
+    }
+
+    // grow the buffer and construct a new element from args at index ind on the way.
+    template<class... Args>
+    T *realloc_insert(size_t ind, Args&&... args) {
+        return realloc_insert_(ind, trivial(), std::forward<Args>(args)...);
+    }
+
+    template<class... Args>
+    T *realloc_insert_(size_t ind, std::true_type, Args&&... args) {
+        T tmp(std::forward<Args>(args)...);
+        size_t n = next_capacity(size() + 1), s = size();
+        if (first == local) {
+            T *p = allocate(n);
+            relocate(first, last, p);
+            first = p;
+        } else {
+            void *p = std::realloc(first, n * sizeof(T));
+            if (p == nullptr) throw std::bad_alloc();
+            first = static_cast<T *>(p);
+        }
+        last = first + s;
+        bound = first + n;
+        return shift_insert(ind, std::move(tmp));
+    }
+
+    // the new element is built first because args may refer into the old buffer.
+    template<class... Args>
+    T *realloc_insert_(size_t ind, std::false_type, Args&&... args) {
+        size_t n = next_capacity(size() + 1);
+        T *p = allocate(n), *q = p + ind;
+        try {
+            new (q) T(std::forward<Args>(args)...);
+        } catch (...) {
+            deallocate(p);
+            throw;
+        }
+        try {
+            relocate(first, first + ind, p);
+        } catch (...) {
+            q->~T();
+            deallocate(p);
+            throw;
+        }
+        T *e;
+        try {
+            e = relocate(first + ind, last, q + 1);
+        } catch (...) {
+            destroy(p, q + 1);
+            deallocate(p);
+            throw;
+        }
+        destroy(first, last);
+        release(first);
+        first = p;
+        last = e;
+        bound = p + n;
+        return q;
+    }
+
+    // make room at index ind inside the current buffer and construct a new element there.
+    template<class... Args>
+    T *shift_insert(size_t ind, Args&&... args) {
+        if (ind == size()) {
+            new (last) T(std::forward<Args>(args)...);
+            return last++;
+        }
+        return shift_insert_(ind, trivial(), std::forward<Args>(args)...);
+    }
+
+    template<class... Args>
+    T *shift_insert_(size_t ind, std::true_type, Args&&... args) {
+        T tmp(std::forward<Args>(args)...);
+        std::memmove(first + ind + 1, first + ind, (size() - ind) * sizeof(T));
+        new (first + ind) T(tmp);
+        ++last;
+        return first + ind;
+    }
+
+    template<class... Args>
+    T *shift_insert_(size_t ind, std::false_type, Args&&... args) {
+        T tmp(std::forward<Args>(args)...);
+        new (last) T(std::move(*(last - 1)));
+        ++last;
+        for (T *t = last - 2; t != first + ind; --t)
+            *t = std::move(*(t - 1));
+        first[ind] = std::move(tmp);
+        return first + ind;
+    }
+
+    // *this is empty: take over the buffer of other, or move its elements over
+    // one by one if they live in a small_vector's inline buffer.
+    void take(vector &other) {
+        if (other.first == other.local) {
+            if (other.size() > capacity()) reallocate(other.size());
+            last = relocate(other.first, other.last, first);
+            other.clear();
+            return;
+        }
+        release(first);
+        first = other.first;
+        last = other.last;
+        bound = other.bound;
+        other.first = other.last = other.local;
+        other.bound = other.local + other.local_cap;
+    }
+
+    // remove the element at index ind, pulling the tail one slot forward.
+    void shift_erase(size_t ind) {
+        shift_erase(ind, trivial());
+    }
+
+    void shift_erase(size_t ind, std::true_type) {
+        first[ind].~T();
+        std::memmove(first + ind, first + ind + 1, (size() - ind - 1) * sizeof(T));
+        --last;
+    }
+
+    void shift_erase(size_t ind, std::false_type) {
+        for (T *t = first + ind; t + 1 != last; ++t)
+            *t = std::move(*(t + 1));
+        (--last)->~T();
+    }
+
+    // move everything into a buffer of exactly n (>= size) slots.
+    void reallocate(size_t n) {
+        reallocate(n, trivial());
+    }
+
+    void reallocate(size_t n, std::true_type) {
+        size_t s = size();
+        if (first == local || n == 0) {
+            T *p = allocate(n);
+            relocate(first, last, p);
+            release(first);
+            first = p;
+        } else {
+            void *p = std::realloc(first, n * sizeof(T));
+            if (p == nullptr) throw std::bad_alloc();
+            first = static_cast<T *>(p);
+        }
+        last = first + s;
+        bound = first + n;
+    }
+
+    void reallocate(size_t n, std::false_type) {
+        T *p = allocate(n), *q;
+        try {
+            q = relocate(first, last, p);
+        } catch (...) {
+            deallocate(p);
+            throw;
+        }
+        destroy(first, last);
+        release(first);
+        first = p;
+        last = q;
+        bound = p + n;
+    }
+
+    template<class InputIt>
+    static size_t distance(InputIt b, InputIt e) {
+        size_t k = 0;
+        for (; b != e; ++b) ++k;
+        return k;
+    }
+
+    // a forward range is counted first and copied with one shift of the tail.
+    template<class ForwardIt>
+    void range_insert(size_t ind, ForwardIt b, ForwardIt e, std::forward_iterator_tag) {
+        range_insert(ind, b, e, distance(b, e));
+    }
+
+    // a single-pass range can only be read once: at the end it is appended element by
+    // element, elsewhere it is gathered in a temporary vector and moved in from there.
+    template<class InputIt>
+    void range_insert(size_t ind, InputIt b, InputIt e, std::input_iterator_tag) {
+        if (ind == size()) {
+            for (; b != e; ++b) emplace_back(*b);
+            return;
+        }
+        vector tmp;
+        for (; b != e; ++b) tmp.emplace_back(*b);
+        range_insert(ind, std::make_move_iterator(tmp.first), std::make_move_iterator(tmp.last), tmp.size());
+    }
+
+    // n copies of *v as a forward range, for the counted insert.
+    struct repeat_iterator {
+        const T *v;
+        size_t n;
+        const T &operator*() const {
+            return *v;
+        }
+        repeat_iterator &operator++() {
+            --n;
+            return *this;
+        }
+        bool operator!=(const repeat_iterator &rhs) const {
+            return n != rhs.n;
+        }
+    };
+
+    // copy the k elements of [b, e) to index ind, shifting the tail only once.
+    template<class ForwardIt>
+    void range_insert(size_t ind, ForwardIt b, ForwardIt e, size_t k) {
+        if (k == 0) return;
+        if (size() + k > capacity()) {
+            if (trivial::value) {
+                reallocate(next_capacity(size() + k));
+            } else {
+                size_t n = next_capacity(size() + k);
+                T *p = allocate(n), *q = p + ind, *t = q;
+                try {
+                    for (; b != e; ++b, ++t) new (t) T(*b);
+                } catch (...) {
+                    destroy(q, t);
+                    deallocate(p);
+                    throw;
+                }
+                try {
+                    relocate(first, first + ind, p);
+                } catch (...) {
+                    destroy(q, t);
+                    deallocate(p);
+                    throw;
+                }
+                try {
+                    t = relocate(first + ind, last, t);
+                } catch (...) {
+                    destroy(p, q + k);
+                    deallocate(p);
+                    throw;
+                }
+                destroy(first, last);
+                release(first);
+                first = p;
+                last = t;
+                bound = p + n;
+                return;
+            }
+        }
+        range_shift(ind, b, e, k, trivial());
+    }
+
+    template<class ForwardIt>
+    void range_shift(size_t ind, ForwardIt b, ForwardIt e, size_t k, std::true_type) {
+        T *pos = first + ind;
+        std::memmove(pos + k, pos, (last - pos) * sizeof(T));
+        for (; b != e; ++b, ++pos) new (pos) T(*b);
+        last += k;
+    }
+
+    // the slots overwritten at the end only hold moved-from objects, so they are
+    // move assigned from a fresh copy rather than copy assigned.
+    template<class ForwardIt>
+    void range_shift(size_t ind, ForwardIt b, ForwardIt e, size_t k, std::false_type) {
+        T *pos = first + ind, *old = last;
+        size_t after = last - pos;
+        if (after > k) {
+            last = relocate(last - k, last, last);
+            for (T *t = old - k; t != pos; ) {
+                --t;
+                *(t + k) = std::move(*t);
+            }
+            for (; b != e; ++b, ++pos) *pos = T(*b);
+        } else {
+            ForwardIt mid = b;
+            for (size_t i = 0; i < after; ++i) ++mid;
+            for (ForwardIt i = mid; i != e; ++i, ++last) new (last) T(*i);
+            last = relocate(pos, old, last);
+            for (; b != mid; ++b, ++pos) *pos = T(*b);
+        }
+    }
+
+    // *this is empty: a forward range is counted to allocate once, a single-pass one is appended.
+    template<class ForwardIt>
+    void assign_range(ForwardIt b, ForwardIt e, std::forward_iterator_tag) {
+        size_t k = distance(b, e);
+        if (k > capacity()) reallocate(k);
+        range_insert(0, b, e, k);
+    }
+
+    template<class InputIt>
+    void assign_range(InputIt b, InputIt e, std::input_iterator_tag) {
+        for (; b != e; ++b) emplace_back(*b);
+    }
+
+    // remove the elements with index in [i, j), pulling the tail forward once.
+    void range_erase(size_t i, size_t j) {
+        if (i == j) return;
+        range_erase(i, j, trivial());
+    }
+
+    void range_erase(size_t i, size_t j, std::true_type) {
+        std::memmove(first + i, first + j, (last - first - j) * sizeof(T));
+        last -= j - i;
+    }
+
+    void range_erase(size_t i, size_t j, std::false_type) {
+        T *t = first + i;
+        for (T *u = first + j; u != last; ++t, ++u)
+            *t = std::move(*u);
+        destroy(t, last);
+        last = t;
+    }
+
+protected:
+    // used by small_vector to hand over its inline buffer of n slots.
+    vector(T *buf, size_t n) : first(buf), last(buf), bound(buf + n), local(buf), local_cap(n) {}
+
+    // the move assignment for an other which may be a small_vector keeping its elements
+    // inline: those are moved over one by one, which can allocate and throw.
+    void move_from(vector &other) {
+        if (this == &other) return;
+        clear();
+        take(other);
+    }
+
+public:
 	/**
 	 * TODO Constructs
 	 * Atleast three: default constructor, copy constructor and a constructor for std::vector
 	 */
-	vector() {}
-	vector(const vector &other) {}
+	vector() : first(nullptr), last(nullptr), bound(nullptr), local(nullptr), local_cap(0) {}
+	vector(const vector &other) : first(nullptr), last(nullptr), bound(nullptr), local(nullptr), local_cap(0) {
+        size_t n = other.size();
+        first = allocate(n);
+        try {
+            last = copy_construct(other.first, other.last, first);
+        } catch (...) {
+            deallocate(first);
+            throw;
+        }
+        bound = first + n;
+    }
+	/**
+	 * takes over the buffer of other in O(1), other is left empty.
+	 * other must own its buffer: a small_vector goes through the overload below and
+	 * must not be moved from through a vector &&, see small_vector.hpp.
+	 */
+	vector(vector &&other) noexcept : first(nullptr), last(nullptr), bound(nullptr), local(nullptr), local_cap(0) {
+        take(other);
+    }
+	/**
+	 * moves the elements of a small_vector over, see small_vector.hpp.
+	 * not noexcept: elements still in its inline buffer are moved one by one.
+	 */
+	template<size_t N>
+	vector(small_vector<T, N> &&other);
 	/**
 	 * TODO Destructor
 	 */
-	~vector() {}
+	~vector() {
+        destroy(first, last);
+        release(first);
+    }
 	/**
 	 * TODO Assignment operator
 	 */
-	vector &operator=(const vector &other) {}
+	vector &operator=(const vector &other) {
+        if (this == &other) return *this;
+        clear();
+        if (other.size() > capacity()) {
+            T *p = allocate(other.size());
+            release(first);
+            first = last = p;
+            bound = p + other.size();
+        }
+        last = copy_construct(other.first, other.last, first);
+        return *this;
+    }
+	/**
+	 * same as the move constructor, other must own its buffer.
+	 */
+	vector &operator=(vector &&other) noexcept {
+        if (this == &other) return *this;
+        clear();
+        take(other);
+        return *this;
+    }
+	template<size_t N>
+	vector &operator=(small_vector<T, N> &&other);
 	/**
 	 * assigns specified element with bounds checking
 	 * throw index_out_of_bound if pos is not in [0, size)
 	 */
-	T & at(const size_t &pos) {}
-	const T & at(const size_t &pos) const {}
+	T & at(const size_t &pos) {
+        if (pos >= size())
+            throw index_out_of_bound();
+        return first[pos];
+    }
+	const T & at(const size_t &pos) const {
+        if (pos >= size())
+            throw index_out_of_bound();
+        return first[pos];
+    }
 	/**
 	 * assigns specified element with bounds checking
 	 * throw index_out_of_bound if pos is not in [0, size)
 	 * !!! Pay attentions
 	 *   In STL this operator does not check the boundary but I want you to do.
 	 */
-	T & operator[](const size_t &pos) {}
-	const T & operator[](const size_t &pos) const {}
+	T & operator[](const size_t &pos) {
+        if (pos >= size())
+            throw index_out_of_bound();
+        return first[pos];
+    }
+	const T & operator[](const size_t &pos) const {
+        if (pos >= size())
+            throw index_out_of_bound();
+        return first[pos];
+    }
 	/**
 	 * access the first element.
 	 * throw container_is_empty if size == 0
 	 */
-	const T & front() const {}
+	const T & front() const {
+        if (first == last)
+            throw container_is_empty();
+        return *first;
+    }
 	/**
 	 * access the last element.
 	 * throw container_is_empty if size == 0
 	 */
-	const T & back() const {}
+	const T & back() const {
+        if (first == last)
+            throw container_is_empty();
+        return *(last - 1);
+    }
 	/**
 	 * returns an iterator to the beginning.
 	 */
-	iterator begin() {}
-	const_iterator cbegin() const {}
+	iterator begin() {
+        return iterator(first, this);
+    }
+	const_iterator cbegin() const {
+        return const_iterator(first, this);
+    }
 	/**
 	 * returns an iterator to the end.
 	 */
-	iterator end() {}
-	const_iterator cend() const {}
+	iterator end() {
+        return iterator(last, this);
+    }
+	const_iterator cend() const {
+        return const_iterator(last, this);
+    }
 	/**
 	 * checks whether the container is empty
 	 */
-	bool empty() const {}
+	bool empty() const {
+        return first == last;
+    }
 	/**
 	 * returns the number of elements
 	 */
-	size_t size() const {}
+	size_t size() const {
+        return last - first;
+    }
 	/**
 	 * returns the number of elements that can be held in currently allocated storage.
 	 */
-	size_t capacity() const {}
+	size_t capacity() const {
+        return bound - first;
+    }
 	/**
 	 * clears the contents
 	 */
-	void clear() {}
+	void clear() {
+        destroy(first, last);
+        last = first;
+    }
 	/**
 	 * inserts value before pos
 	 * returns an iterator pointing to the inserted value.
 	 */
-	iterator insert(iterator pos, const T &value) {}
+	iterator insert(iterator pos, const T &value) {
+        if (pos.v != this)
+            throw invalid_iterator();
+        return insert(pos.p - first, value);
+    }
 	/**
 	 * inserts value at index ind.
 	 * after inserting, this->at(ind) == value is true
 	 * returns an iterator pointing to the inserted value.
 	 * throw index_out_of_bound if ind > size (in this situation ind can be size because after inserting the size will increase 1.)
 	 */
-	iterator insert(const size_t &ind, const T &value) {}
+	iterator insert(const size_t &ind, const T &value) {
+        return emplace(ind, value);
+    }
+	iterator insert(iterator pos, T &&value) {
+        if (pos.v != this)
+            throw invalid_iterator();
+        return emplace(pos.p - first, std::move(value));
+    }
+	iterator insert(const size_t &ind, T &&value) {
+        return emplace(ind, std::move(value));
+    }
+	/**
+	 * constructs an element from args in place before pos / at index ind.
+	 * returns an iterator pointing to the new element.
+	 * throw index_out_of_bound if ind > size
+	 */
+	template<class... Args>
+	iterator emplace(iterator pos, Args&&... args) {
+        if (pos.v != this)
+            throw invalid_iterator();
+        return emplace(size_t(pos.p - first), std::forward<Args>(args)...);
+    }
+	template<class... Args>
+	iterator emplace(size_t ind, Args&&... args) {
+        if (ind > size())
+            throw index_out_of_bound();
+        if (last == bound)
+            return iterator(realloc_insert(ind, std::forward<Args>(args)...), this);
+        return iterator(shift_insert(ind, std::forward<Args>(args)...), this);
+    }
 	/**
 	 * removes the element at pos.
 	 * return an iterator pointing to the following element.
 	 * If the iterator pos refers the last element, the end() iterator is returned.
 	 */
-	iterator erase(iterator pos) {}
+	iterator erase(iterator pos) {
+        if (pos.v != this)
+            throw invalid_iterator();
+        if (pos.p < first || pos.p >= last)
+            throw invalid_iterator();
+        return erase(pos.p - first);
+    }
 	/**
 	 * removes the element with index ind.
 	 * return an iterator pointing to the following element.
 	 * throw index_out_of_bound if ind >= size
 	 */
-	iterator erase(const size_t &ind) {}
+	iterator erase(const size_t &ind) {
+        if (ind >= size())
+            throw index_out_of_bound();
+        shift_erase(ind);
+        return iterator(first + ind, this);
+    }
 	/**
 	 * adds an element to the end.
 	 */
-	void push_back(const T &value) {}
+	void push_back(const T &value) {
+        emplace_back(value);
+    }
+	void push_back(T &&value) {
+        emplace_back(std::move(value));
+    }
+	/**
+	 * constructs an element from args in place at the end.
+	 */
+	template<class... Args>
+	void emplace_back(Args&&... args) {
+        if (last == bound) {
+            realloc_insert(size(), std::forward<Args>(args)...);
+            return;
+        }
+        new (last) T(std::forward<Args>(args)...);
+        ++last;
+    }
 	/**
 	 * remove the last element from the end.
 	 * throw container_is_empty if size() == 0
 	 */
-	void pop_back() {}
+	void pop_back() {
+        if (first == last)
+            throw container_is_empty();
+        (--last)->~T();
+    }
+	/**
+	 * inserts the elements of [b, e) before pos, shifting the tail only once.
+	 * a single-pass range such as an istream_iterator is read only once.
+	 * returns an iterator pointing to the first inserted value (pos if the range is empty).
+	 * [b, e) must not point into this vector.
+	 */
+	template<class InputIt, class = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+	iterator insert(iterator pos, InputIt b, InputIt e) {
+        if (pos.v != this)
+            throw invalid_iterator();
+        if (pos.p < first || pos.p > last)
+            throw invalid_iterator();
+        size_t ind = pos.p - first;
+        range_insert(ind, b, e, typename std::iterator_traits<InputIt>::iterator_category());
+        return iterator(first + ind, this);
+    }
+	/**
+	 * inserts n copies of value before pos, shifting the tail only once.
+	 * returns an iterator pointing to the first inserted value (pos if n is 0).
+	 */
+	iterator insert(iterator pos, size_t n, const T &value) {
+        if (pos.v != this)
+            throw invalid_iterator();
+        if (pos.p < first || pos.p > last)
+            throw invalid_iterator();
+        size_t ind = pos.p - first;
+        T tmp(value);
+        range_insert(ind, repeat_iterator{&tmp, n}, repeat_iterator{&tmp, 0}, n);
+        return iterator(first + ind, this);
+    }
+	/**
+	 * removes the elements in [b, e).
+	 * returns an iterator pointing to the element following the removed ones.
+	 */
+	iterator erase(iterator b, iterator e) {
+        if (b.v != this || e.v != this)
+            throw invalid_iterator();
+        if (b.p < first || e.p > last || b.p > e.p)
+            throw invalid_iterator();
+        size_t i = b.p - first;
+        range_erase(i, e.p - first);
+        return iterator(first + i, this);
+    }
+	/**
+	 * replaces the contents with a copy of [b, e).
+	 */
+	template<class InputIt, class = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+	void assign(InputIt b, InputIt e) {
+        clear();
+        assign_range(b, e, typename std::iterator_traits<InputIt>::iterator_category());
+    }
+	/**
+	 * replaces the contents with n copies of value.
+	 */
+	void assign(size_t n, const T &value) {
+        T tmp(value);
+        clear();
+        if (n > capacity()) reallocate(n);
+        for (; n; --n, ++last) new (last) T(tmp);
+    }
+	/**
+	 * changes the number of elements to n,
+	 * the new elements are default constructed or copies of value.
+	 */
+	void resize(size_t n) {
+        if (n <= size()) {
+            range_erase(n, size());
+            return;
+        }
+        if (n > capacity()) reallocate(next_capacity(n));
+        for (; last != first + n; ++last) new (last) T();
+    }
+	void resize(size_t n, const T &value) {
+        if (n <= size()) {
+            range_erase(n, size());
+            return;
+        }
+        T tmp(value);
+        if (n > capacity()) reallocate(next_capacity(n));
+        for (; last != first + n; ++last) new (last) T(tmp);
+    }
+	/**
+	 * makes sure the capacity is at least n, so the next n - size() insertions don't reallocate.
+	 */
+	void reserve(size_t n) {
+        if (n > capacity()) reallocate(n);
+    }
+	/**
+	 * releases the unused capacity, a small_vector moves back inline if it fits.
+	 */
+	void shrink_to_fit() {
+        if (first == local) return;
+        if (size() > local_cap) {
+            if (last != bound) reallocate(size());
+            return;
+        }
+        T *q = relocate(first, last, local);
+        destroy(first, last);
+        deallocate(first);
+        first = local;
+        last = q;
+        bound = local + local_cap;
+    }
 };
 
 